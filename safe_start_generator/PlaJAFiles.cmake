@@ -3,6 +3,10 @@ set(SAFE_START_GENERATOR_SOURCES
         ${CMAKE_CURRENT_LIST_DIR}/safe_start_generator.h
         ${CMAKE_CURRENT_LIST_DIR}/start_generation_statistics.h
         ${CMAKE_CURRENT_LIST_DIR}/start_generation_statistics.cpp
+        ${CMAKE_CURRENT_LIST_DIR}/start_generator_options.h
+        ${CMAKE_CURRENT_LIST_DIR}/start_generator_options.cpp
+        ${CMAKE_CURRENT_LIST_DIR}/state_valuation.h
+        ${CMAKE_CURRENT_LIST_DIR}/deadline.h
 )
 
 # Include all files from the verification_methods directory
@@ -17,6 +21,20 @@ list(APPEND SAFE_START_GENERATOR_SOURCES ${TESTING_SOURCES})
 include(${CMAKE_CURRENT_LIST_DIR}/strengthening_strategy/PlaJAFiles.cmake)
 list(APPEND SAFE_START_GENERATOR_SOURCES ${STRENGTHENING_STRATEGY_SOURCES})
 
+# Include decision diagram files.
+include(${CMAKE_CURRENT_LIST_DIR}/decision_diagrams/PlaJAFiles.cmake)
+list(APPEND SAFE_START_GENERATOR_SOURCES ${DECISION_DIAGRAMS_SOURCES})
+
 # Include approximation methods files.
 include(${CMAKE_CURRENT_LIST_DIR}/approximation_methods/PlaJAFiles.cmake)
 list(APPEND SAFE_START_GENERATOR_SOURCES ${APPROXIMATION_METHODS_SOURCES})
+
+# Include benchmark files (separate executable, see add_safe_start_benchmark).
+include(${CMAKE_CURRENT_LIST_DIR}/benchmark/PlaJAFiles.cmake)
+if (BUILD_SAFE_START_BENCHMARK)
+    # The PlaJA library target is only defined after this file is included.
+    cmake_language(DEFER CALL add_safe_start_benchmark_if_available)
+endif ()
+
+# Include offline tools (separate executables, independent of PlaJA).
+include(${CMAKE_CURRENT_LIST_DIR}/tools/PlaJAFiles.cmake)
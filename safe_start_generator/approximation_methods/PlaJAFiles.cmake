@@ -1,7 +1,15 @@
 set(APPROXIMATION_METHODS_SOURCES
         ${CMAKE_CURRENT_LIST_DIR}/bounding_box.h
         ${CMAKE_CURRENT_LIST_DIR}/bounding_box.cpp
+        ${CMAKE_CURRENT_LIST_DIR}/box_accumulator.h
+        ${CMAKE_CURRENT_LIST_DIR}/box_accumulator.cpp
         ${CMAKE_CURRENT_LIST_DIR}/bounded_box.h
         ${CMAKE_CURRENT_LIST_DIR}/bounded_box.cpp
+        ${CMAKE_CURRENT_LIST_DIR}/multi_box.h
+        ${CMAKE_CURRENT_LIST_DIR}/multi_box.cpp
+        ${CMAKE_CURRENT_LIST_DIR}/template_polyhedron.h
+        ${CMAKE_CURRENT_LIST_DIR}/template_polyhedron.cpp
+        ${CMAKE_CURRENT_LIST_DIR}/decision_tree.h
+        ${CMAKE_CURRENT_LIST_DIR}/decision_tree.cpp
 
 )
\ No newline at end of file
@@ -12,6 +12,10 @@ namespace Approximation {
     enum class Type {
         Overapproximation,
         Underapproximation,
+        MultiUnderapproximation, // several disjoint boxes, leftover states are excluded individually.
+        Octagon,                 // overapproximation by bounds on x_i, x_i + x_j and x_i - x_j.
+        Hull,                    // overapproximation by a template polyhedron close to the convex hull.
+        DecisionTree,            // unsafe leaves of a decision tree separating unsafe from observed-safe states.
         None
     };
 
@@ -19,6 +23,10 @@ namespace Approximation {
         switch (type) {
             case Type::Overapproximation: return "over";
             case Type::Underapproximation: return "under";
+            case Type::MultiUnderapproximation: return "multi_under";
+            case Type::Octagon: return "octagon";
+            case Type::Hull: return "hull";
+            case Type::DecisionTree: return "tree";
             case Type::None: return "none";
             default: throw std::invalid_argument("Unknown approximation type");
         }
@@ -27,6 +35,10 @@ namespace Approximation {
     inline Type string_to_type(const std::string& type_str) {
         if (type_str == "over") return Type::Overapproximation;
         if (type_str == "under") return Type::Underapproximation;
+        if (type_str == "multi_under") return Type::MultiUnderapproximation;
+        if (type_str == "octagon") return Type::Octagon;
+        if (type_str == "hull") return Type::Hull;
+        if (type_str == "tree") return Type::DecisionTree;
         if (type_str == "none") return Type::None;
         throw std::invalid_argument("Invalid approximation type string: " + type_str);
     }
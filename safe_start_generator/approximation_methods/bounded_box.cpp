@@ -23,7 +23,8 @@ std::vector<int> BoundedBox::get_state_vec(const StateBase& state) {
 
 std::pair<size_t,std::unique_ptr<Expression>> BoundedBox::compute_bounded_box(
     const std::unordered_set<std::unique_ptr<StateBase>>& state_set,
-    const Model& model) {
+    const Model& model,
+    Corners* corners) {
 
     // construct state set for faster lookup.
     ValuationSet val_set;
@@ -36,63 +37,81 @@ std::pair<size_t,std::unique_ptr<Expression>> BoundedBox::compute_bounded_box(
 
     // find maximal bounded box.
     for (const auto& state: state_set) {
+        auto [min_corner, max_corner] = grow_box(get_state_vec(*state), val_set, model);
 
-        auto center = get_state_vec(*state);
-        std::vector<int> min_corner = center;
-        std::vector<int> max_corner = center;
-
-        // expand in all directions.
-        bool fixed_point = false;
-        while (!fixed_point) {
-            fixed_point = true;
-            for (size_t dim = 0; dim < center.size(); dim++) {
-                min_corner[dim] -= 1;
-                if (!is_bounded(min_corner, max_corner, val_set, model)) {
-                    min_corner[dim] += 1; // revert
-                } else {
-                    fixed_point = false;
-                }
-
-                max_corner[dim] += 1;
-                if (!is_bounded(max_corner, min_corner, val_set, model)) {
-                    max_corner[dim] -= 1; // revert
-                } else {
-                    fixed_point = false;
-                }
-            }
+        // update current max box.
+        const size_t box_volume = volume(min_corner, max_corner);
+        if (box_volume > max_volume) {
+            max_volume = box_volume;
+            best_min = std::move(min_corner);
+            best_max = std::move(max_corner);
         }
+    }
 
-        // compute volume.
-        size_t volume = 1;
-        for (size_t dim = 0; dim < center.size(); dim++) { volume *= max_corner[dim] - min_corner[dim] + 1; }
+    std::cout << "box size: " << max_volume << std::endl;
 
-        // update current max box.
-        if (volume > max_volume) {
-            max_volume = volume;
-            best_min = min_corner;
-            best_max = max_corner;
+    auto box = to_expression(best_min, best_max, model);
+    box->dump(true);
+    if (corners) { *corners = { std::move(best_min), std::move(best_max) }; }
+    return std::make_pair(max_volume,std::move(box));
+}
+
+std::pair<std::vector<int>, std::vector<int>> BoundedBox::grow_box(
+    const std::vector<int>& center,
+    ValuationSet& point_set,
+    const Model& model) {
+    std::vector<int> min_corner = center;
+    std::vector<int> max_corner = center;
+
+    // expand in all directions.
+    bool fixed_point = false;
+    while (!fixed_point) {
+        fixed_point = true;
+        for (size_t dim = 0; dim < center.size(); dim++) {
+            min_corner[dim] -= 1;
+            if (!is_bounded(min_corner, max_corner, point_set, model)) {
+                min_corner[dim] += 1; // revert
+            } else {
+                fixed_point = false;
+            }
+
+            max_corner[dim] += 1;
+            if (!is_bounded(min_corner, max_corner, point_set, model)) {
+                max_corner[dim] -= 1; // revert
+            } else {
+                fixed_point = false;
+            }
         }
     }
+    return { std::move(min_corner), std::move(max_corner) };
+}
 
-    std::cout << "box size: " << max_volume << std::endl;
+size_t BoundedBox::volume(const std::vector<int>& min_corner, const std::vector<int>& max_corner) {
+    size_t box_volume = 1;
+    for (size_t dim = 0; dim < min_corner.size(); dim++) { box_volume *= max_corner[dim] - min_corner[dim] + 1; }
+    return box_volume;
+}
 
+std::unique_ptr<Expression> BoundedBox::to_expression(
+    const std::vector<int>& min_corner,
+    const std::vector<int>& max_corner,
+    const Model& model) {
     auto box = std::make_unique<NaryExpression>(BinaryOpExpression::AND);
-    for (size_t var_index = 0; var_index < best_min.size(); ++var_index) {
+    for (size_t var_index = 0; var_index < min_corner.size(); ++var_index) {
         const auto var_dec = model.get_variable(var_index);
         auto var_expr = model.gen_var_expr(var_index, var_dec);
 
         auto lower = std::make_unique<BinaryOpExpression>(BinaryOpExpression::GE);
         lower->set_left(var_expr->deepCopy_Exp());
-        lower->set_right(std::make_unique<IntegerValueExpression>(best_min[var_index]));
+        lower->set_right(std::make_unique<IntegerValueExpression>(min_corner[var_index]));
         box->add_sub(std::move(lower));
 
         auto upper = std::make_unique<BinaryOpExpression>(BinaryOpExpression::LE);
         upper->set_left(std::move(var_expr));
-        upper->set_right(std::make_unique<IntegerValueExpression>(best_max[var_index]));
+        upper->set_right(std::make_unique<IntegerValueExpression>(max_corner[var_index]));
         box->add_sub(std::move(upper));
     }
-    box->dump(true);
-    return std::make_pair(max_volume,std::move(box));
+    return box;
 }
 
 bool BoundedBox::is_bounded(
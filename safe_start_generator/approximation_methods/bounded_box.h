@@ -28,14 +28,38 @@ using ValuationSet = std::unordered_set<std::vector<int>,VectorHash>;
  */
 class BoundedBox {
 public:
+    /// min and max corner of a box, excluding loc variable.
+    using Corners = std::pair<std::vector<int>, std::vector<int>>;
+
+    /// @param corners (optional) set to the corners of the box.
     static std::pair<size_t,std::unique_ptr<Expression>> compute_bounded_box(
         const std::unordered_set<std::unique_ptr<StateBase>>& state_set,
+        const Model& model,
+        Corners* corners = nullptr);
+
+    /**
+     * @brief grows a box around center as long as it stays bounded by point_set.
+     *
+     * @return min and max corner of the grown box.
+     */
+    static std::pair<std::vector<int>, std::vector<int>> grow_box(
+        const std::vector<int>& center,
+        ValuationSet& point_set,
+        const Model& model);
+
+    /// @return number of points in box.
+    static size_t volume(const std::vector<int>& min_corner, const std::vector<int>& max_corner);
+
+    /// @return conjunction of the variable bounds of box.
+    static std::unique_ptr<Expression> to_expression(
+        const std::vector<int>& min_corner,
+        const std::vector<int>& max_corner,
         const Model& model);
 
-private:
     /// transforms state into a simple integer vector excluding loc variable.
     static std::vector<int> get_state_vec(const StateBase& state);
 
+private:
     /**
      * @brief checks if box represented by corners is bounded by set.
      *
@@ -5,6 +5,8 @@
 #ifndef BOX_APPROXIMATION_H
 #define BOX_APPROXIMATION_H
 #include "../../fd_adaptions/state.h"
+#include "bounded_box.h"
+#include "box_accumulator.h"
 
 /**
  * Computes an overapproximation of a set of states by finding the minimal box containing all state in a given state set.
@@ -14,6 +16,14 @@ public:
     static std::pair<double,std::unique_ptr<Expression>> compute_bounding_box(
         const std::unordered_set<std::unique_ptr<StateBase>>& state_set,
         const Model& model);
+
+    /// box of the states accumulated so far, e.g., incrementally while testing.
+    static std::pair<double,std::unique_ptr<Expression>> compute_bounding_box(
+        const StartGenerator::BoxAccumulator& bounds,
+        const Model& model);
+
+    /// @return corners of the box of the accumulated states.
+    static BoundedBox::Corners get_corners(const StartGenerator::BoxAccumulator& bounds, const Model& model);
 };
 
 #endif //BOX_APPROXIMATION_H
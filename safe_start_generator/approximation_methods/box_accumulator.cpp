@@ -0,0 +1,35 @@
+//
+// Created by Daniel Sherbakov in 2025.
+//
+
+#include "box_accumulator.h"
+
+#include "../../../parser/ast/model.h"
+#include "../../states/state_base.h"
+
+#include <algorithm>
+#include <climits>
+
+namespace StartGenerator {
+
+    BoxAccumulator::BoxAccumulator(const Model& model):
+        num_vars(model.get_number_variables()),
+        lower(num_vars + 1, INT_MAX),
+        upper(num_vars + 1, INT_MIN) {}
+
+    void BoxAccumulator::add(const StateBase& state) {
+        for (std::size_t var = 1; var <= num_vars; ++var) {
+            const int value = state.get_int(var);
+            lower[var] = std::min(lower[var], value);
+            upper[var] = std::max(upper[var], value);
+        }
+        ++num_states;
+    }
+
+    void BoxAccumulator::clear() {
+        std::fill(lower.begin(), lower.end(), INT_MAX);
+        std::fill(upper.begin(), upper.end(), INT_MIN);
+        num_states = 0;
+    }
+
+} // namespace StartGenerator
@@ -0,0 +1,47 @@
+//
+// Created by Daniel Sherbakov in 2025.
+//
+
+#ifndef BOX_ACCUMULATOR_H
+#define BOX_ACCUMULATOR_H
+
+#include "../../states/forward_states.h"
+
+#include <cstddef>
+#include <vector>
+
+class Model;
+
+namespace StartGenerator {
+
+    /**
+     * @brief Bounds of a growing set of states, i.e., the data of their bounding box.
+     *
+     * The generator adds each unsafe state of a testing phase while it collects them, so that building the box at
+     * refinement does not take another pass over the states.
+     */
+    class BoxAccumulator {
+    public:
+        explicit BoxAccumulator(const Model& model);
+
+        void add(const StateBase& state);
+
+        /// @return number of states added since the last clear.
+        [[nodiscard]] std::size_t size() const { return num_states; }
+        [[nodiscard]] bool empty() const { return num_states == 0; }
+        void clear();
+
+        /// bounds of state index `var`, 1 to the number of variables (the location is not tracked).
+        [[nodiscard]] int lower_bound(std::size_t var) const { return lower[var]; }
+        [[nodiscard]] int upper_bound(std::size_t var) const { return upper[var]; }
+
+    private:
+        const std::size_t num_vars;
+        std::vector<int> lower; // per state index.
+        std::vector<int> upper;
+        std::size_t num_states = 0;
+    };
+
+} // namespace StartGenerator
+
+#endif //BOX_ACCUMULATOR_H
@@ -0,0 +1,155 @@
+//
+// Created by Daniel Sherbakov in 2025.
+//
+
+#include "decision_tree.h"
+
+#include <algorithm>
+#include <climits>
+
+namespace {
+    /// weighted Gini impurity of a partition side.
+    double gini(const double unsafe, const double safe) {
+        const double total = unsafe + safe;
+        if (total == 0) { return 0; }
+        return total - (unsafe * unsafe + safe * safe) / total;
+    }
+}
+
+MultiBox::Cover DecisionTree::compute_unsafe_leaves(
+    const std::unordered_set<std::unique_ptr<StateBase>>& unsafe_states,
+    const std::vector<std::vector<int>>& safe_samples,
+    const Model& model,
+    const size_t max_depth) {
+    std::cout << "Training decision tree on " << unsafe_states.size() << " unsafe and " << safe_samples.size()
+              << " safe samples ..." << '\n';
+
+    // column layout: per variable values of all samples.
+    Samples samples;
+    samples.num_unsafe = unsafe_states.size();
+    const auto num_samples = unsafe_states.size() + safe_samples.size();
+    const auto num_vars = static_cast<size_t>(model.get_number_variables());
+    samples.columns.assign(num_vars, std::vector<int>(num_samples));
+    samples.unsafe_states.reserve(unsafe_states.size());
+    size_t sample = 0;
+    for (const auto& state: unsafe_states) {
+        for (size_t var = 0; var < num_vars; ++var) { samples.columns[var][sample] = state->get_int(var + 1); }
+        samples.unsafe_states.push_back(state.get());
+        ++sample;
+    }
+    for (const auto& safe: safe_samples) {
+        for (size_t var = 0; var < num_vars; ++var) { samples.columns[var][sample] = safe[var]; }
+        ++sample;
+    }
+
+    std::vector<size_t> indices(num_samples);
+    for (size_t i = 0; i < num_samples; ++i) { indices[i] = i; }
+
+    MultiBox::Cover cover;
+    build(samples, indices, 0, num_samples, 0, max_depth, model, cover);
+    std::cout << cover.boxes.size() << " unsafe leaves cover " << cover.covered << " of " << unsafe_states.size()
+              << " states." << std::endl;
+    return cover;
+}
+
+void DecisionTree::build(
+    const Samples& samples,
+    std::vector<size_t>& indices,
+    const size_t begin,
+    const size_t end,
+    const size_t depth,
+    const size_t max_depth,
+    const Model& model,
+    MultiBox::Cover& cover) {
+    const auto first_safe = std::partition(indices.begin() + begin, indices.begin() + end, [&samples](size_t i) {
+        return samples.is_unsafe(i);
+    });
+    const auto num_unsafe = static_cast<size_t>(first_safe - (indices.begin() + begin));
+    if (num_unsafe == 0) { return; } // safe leaf.
+
+    if (num_unsafe == end - begin) { // pure unsafe leaf: bounding box of its states.
+        const auto num_vars = samples.columns.size();
+        std::vector<int> min_corner(num_vars, INT_MAX);
+        std::vector<int> max_corner(num_vars, INT_MIN);
+        for (size_t var = 0; var < num_vars; ++var) {
+            const auto& column = samples.columns[var];
+            for (auto i = begin; i < end; ++i) {
+                min_corner[var] = std::min(min_corner[var], column[indices[i]]);
+                max_corner[var] = std::max(max_corner[var], column[indices[i]]);
+            }
+        }
+        cover.boxes.push_back(BoundedBox::to_expression(min_corner, max_corner, model));
+        cover.corners.emplace_back(std::move(min_corner), std::move(max_corner));
+        cover.covered += num_unsafe;
+        return;
+    }
+
+    Split split {};
+    if (depth >= max_depth or end - begin < min_split_size or not find_split(samples, indices, begin, end, split)) {
+        // impure leaf: unsafe states are excluded individually.
+        for (auto i = begin; i < begin + num_unsafe; ++i) {
+            cover.leftover.push_back(samples.unsafe_states[indices[i]]);
+        }
+        return;
+    }
+
+    const auto& column = samples.columns[split.var];
+    const auto middle = std::partition(indices.begin() + begin, indices.begin() + end, [&](size_t i) {
+        return column[i] <= split.threshold;
+    });
+    const auto mid = static_cast<size_t>(middle - indices.begin());
+    build(samples, indices, begin, mid, depth + 1, max_depth, model, cover);
+    build(samples, indices, mid, end, depth + 1, max_depth, model, cover);
+}
+
+bool DecisionTree::find_split(
+    const Samples& samples,
+    const std::vector<size_t>& indices,
+    const size_t begin,
+    const size_t end,
+    Split& best) {
+    double total_unsafe = 0;
+    for (auto i = begin; i < end; ++i) { total_unsafe += samples.is_unsafe(indices[i]); }
+    const double total_safe = static_cast<double>(end - begin) - total_unsafe;
+    best.impurity = gini(total_unsafe, total_safe);
+    bool found = false;
+
+    std::vector<double> unsafe_hist;
+    std::vector<double> safe_hist;
+    for (size_t var = 0; var < samples.columns.size(); ++var) {
+        const auto& column = samples.columns[var];
+        int min_value = INT_MAX;
+        int max_value = INT_MIN;
+        for (auto i = begin; i < end; ++i) {
+            min_value = std::min(min_value, column[indices[i]]);
+            max_value = std::max(max_value, column[indices[i]]);
+        }
+        if (min_value == max_value) { continue; }
+
+        // histogram over the value range of the node.
+        const auto range = static_cast<size_t>(static_cast<int64_t>(max_value) - min_value + 1);
+        const size_t bin_width = (range + max_bins - 1) / max_bins;
+        const size_t num_bins = (range + bin_width - 1) / bin_width;
+        unsafe_hist.assign(num_bins, 0);
+        safe_hist.assign(num_bins, 0);
+        for (auto i = begin; i < end; ++i) {
+            const auto bin = static_cast<size_t>(column[indices[i]] - min_value) / bin_width;
+            if (samples.is_unsafe(indices[i])) { ++unsafe_hist[bin]; } else { ++safe_hist[bin]; }
+        }
+
+        // sweep thresholds between bins.
+        double left_unsafe = 0;
+        double left_safe = 0;
+        for (size_t bin = 0; bin + 1 < num_bins; ++bin) {
+            left_unsafe += unsafe_hist[bin];
+            left_safe += safe_hist[bin];
+            const double impurity =
+                gini(left_unsafe, left_safe) + gini(total_unsafe - left_unsafe, total_safe - left_safe);
+            if (impurity < best.impurity - 1e-9) {
+                best = { var, min_value + static_cast<int>((bin + 1) * bin_width) - 1, impurity };
+                found = true;
+            }
+        }
+    }
+    return found;
+}
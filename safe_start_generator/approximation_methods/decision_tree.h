@@ -0,0 +1,64 @@
+//
+// Created by Daniel Sherbakov in 2025.
+//
+
+#ifndef DECISION_TREE_H
+#define DECISION_TREE_H
+#include "multi_box.h"
+
+/**
+ * Approximates a set of unsafe states by the leaves of an axis-aligned decision tree trained on the unsafe states
+ * against observed-safe states.
+ *
+ * Splits minimize the Gini impurity. Candidate thresholds are found with per-variable histograms over the value range
+ * of a node (at most `max_bins` bins), so training is linear in the number of samples per tree level.
+ * Each pure unsafe leaf yields the bounding box of its unsafe states, which contains no observed-safe state.
+ * Unsafe states in impure leaves (depth or size limit) are left over to be excluded individually.
+ * Without safe samples, the tree degenerates to the bounding box of the unsafe set.
+ */
+class DecisionTree {
+public:
+    /**
+     * @param safe_samples valuations observed to be safe, excluding loc variable.
+     *
+     * @return boxes of the pure unsafe leaves and the states they do not cover.
+     */
+    static MultiBox::Cover compute_unsafe_leaves(
+        const std::unordered_set<std::unique_ptr<StateBase>>& unsafe_states,
+        const std::vector<std::vector<int>>& safe_samples,
+        const Model& model,
+        size_t max_depth = 12);
+
+private:
+    static constexpr size_t max_bins = 256;
+    static constexpr size_t min_split_size = 4;
+
+    struct Samples {
+        std::vector<std::vector<int>> columns; // per variable, unsafe samples first.
+        size_t num_unsafe = 0;
+        std::vector<const StateBase*> unsafe_states;
+
+        [[nodiscard]] bool is_unsafe(const size_t sample) const { return sample < num_unsafe; }
+    };
+
+    struct Split {
+        size_t var;
+        int threshold; // left: value <= threshold.
+        double impurity;
+    };
+
+    static void build(
+        const Samples& samples,
+        std::vector<size_t>& indices,
+        size_t begin,
+        size_t end,
+        size_t depth,
+        size_t max_depth,
+        const Model& model,
+        MultiBox::Cover& cover);
+
+    /// @return best split of indices[begin, end), if any reduces the impurity.
+    static bool find_split(const Samples& samples, const std::vector<size_t>& indices, size_t begin, size_t end, Split& best);
+};
+
+#endif //DECISION_TREE_H
@@ -0,0 +1,68 @@
+//
+// Created by Daniel Sherbakov in 2025.
+//
+
+#include "multi_box.h"
+
+#include <cmath>
+#include <unordered_map>
+
+MultiBox::Cover MultiBox::compute_multi_box(
+    const std::unordered_set<std::unique_ptr<StateBase>>& state_set,
+    const Model& model,
+    const size_t max_boxes,
+    const double coverage) {
+
+    // states not covered yet.
+    ValuationSet remaining;
+    std::unordered_map<std::vector<int>, const StateBase*, VectorHash> states;
+    remaining.reserve(state_set.size());
+    for (auto const& state: state_set) {
+        auto state_vec = BoundedBox::get_state_vec(*state);
+        remaining.insert(state_vec);
+        states.emplace(std::move(state_vec), state.get());
+    }
+
+    Cover cover;
+    const auto target = static_cast<size_t>(std::ceil(coverage * static_cast<double>(state_set.size())));
+    while (cover.boxes.size() < max_boxes and cover.covered < target and not remaining.empty()) {
+
+        // maximal bounded box among the remaining states.
+        std::vector<int> best_min, best_max;
+        size_t max_volume = 0;
+        const std::vector<std::vector<int>> centers(remaining.begin(), remaining.end());
+        for (const auto& center: centers) {
+            auto [min_corner, max_corner] = BoundedBox::grow_box(center, remaining, model);
+            const size_t box_volume = BoundedBox::volume(min_corner, max_corner);
+            if (box_volume > max_volume) {
+                max_volume = box_volume;
+                best_min = std::move(min_corner);
+                best_max = std::move(max_corner);
+            }
+        }
+        if (max_volume <= 1) { break; } // single points are excluded individually anyway.
+
+        // remove covered states.
+        auto current = best_min;
+        while (true) {
+            remaining.erase(current);
+            size_t dim = current.size();
+            while (dim-- > 0) {
+                if (++current[dim] <= best_max[dim]) { break; }
+                current[dim] = best_min[dim];
+            }
+            if (dim == static_cast<size_t>(-1)) { break; } // all points processed.
+        }
+
+        cover.covered += max_volume;
+        cover.boxes.push_back(BoundedBox::to_expression(best_min, best_max, model));
+        cover.corners.emplace_back(std::move(best_min), std::move(best_max));
+    }
+
+    cover.leftover.reserve(remaining.size());
+    for (const auto& state_vec: remaining) { cover.leftover.push_back(states.at(state_vec)); }
+
+    std::cout << cover.boxes.size() << " boxes cover " << cover.covered << " of " << state_set.size() << " states."
+              << std::endl;
+    return cover;
+}
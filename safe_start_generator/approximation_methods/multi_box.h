@@ -0,0 +1,33 @@
+//
+// Created by Daniel Sherbakov in 2025.
+//
+
+#ifndef MULTI_BOX_H
+#define MULTI_BOX_H
+#include "bounded_box.h"
+
+/**
+ * Computes an underapproximation for a set of states by greedily covering it with disjoint boxes contained within the
+ * set of states. Each round picks the maximal bounded box (see `BoundedBox`) among the states not yet covered.
+ */
+class MultiBox {
+public:
+    struct Cover {
+        std::vector<std::unique_ptr<Expression>> boxes;
+        std::vector<BoundedBox::Corners> corners; // of the boxes, in the same order.
+        std::vector<const StateBase*> leftover; // states not covered by any box.
+        size_t covered = 0;                     // number of states covered by the boxes.
+    };
+
+    /**
+     * @param max_boxes maximal number of boxes.
+     * @param coverage fraction of the state set after which no further boxes are computed.
+     */
+    static Cover compute_multi_box(
+        const std::unordered_set<std::unique_ptr<StateBase>>& state_set,
+        const Model& model,
+        size_t max_boxes,
+        double coverage);
+};
+
+#endif //MULTI_BOX_H
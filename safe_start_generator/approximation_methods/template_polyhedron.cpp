@@ -0,0 +1,283 @@
+//
+// Created by Daniel Sherbakov in 2025.
+//
+
+#include "template_polyhedron.h"
+
+#include "../../../parser/ast/expression/integer_value_expression.h"
+#include "../../../parser/ast/model.h"
+#include "../../../parser/ast/variable_declaration.h"
+#include "../../information/model_information.h"
+#include "../../parser/ast/expression/binary_op_expression.h"
+#include "../../parser/ast/expression/special_cases/nary_expression.h"
+#include "../testing/rng_stream.h"
+
+#include <algorithm>
+#include <climits>
+#include <cmath>
+#include <iomanip>
+#include <limits>
+#include <numeric>
+#include <set>
+
+namespace {
+    constexpr size_t volume_samples = 1 << 14;
+    constexpr int power_iterations = 64;
+
+    struct Constraint {
+        TemplatePolyhedron::Direction direction;
+        int64_t lower;
+        int64_t upper;
+    };
+
+    int64_t dot(const TemplatePolyhedron::Direction& direction, const std::vector<int>& point) {
+        int64_t result = 0;
+        for (size_t var = 0; var < point.size(); ++var) { result += static_cast<int64_t>(direction[var]) * point[var]; }
+        return result;
+    }
+
+    std::vector<std::vector<int>> to_points(
+        const std::unordered_set<std::unique_ptr<StateBase>>& state_set,
+        const size_t num_vars) {
+        std::vector<std::vector<int>> points;
+        points.reserve(state_set.size());
+        for (const auto& state: state_set) {
+            std::vector<int> point(num_vars);
+            for (size_t var = 0; var < num_vars; ++var) { point[var] = state->get_int(var + 1); } // skip loc variable.
+            points.push_back(std::move(point));
+        }
+        return points;
+    }
+
+    bool satisfies(const std::vector<Constraint>& constraints, const std::vector<int>& point) {
+        return std::all_of(constraints.begin(), constraints.end(), [&point](const Constraint& constraint) {
+            const auto value = dot(constraint.direction, point);
+            return constraint.lower <= value and value <= constraint.upper;
+        });
+    }
+
+    /// @return d·x as expression, e.g., x_0 + (-1 * x_1).
+    std::unique_ptr<Expression> to_linear_term(const TemplatePolyhedron::Direction& direction, const Model& model) {
+        std::unique_ptr<Expression> term;
+        for (size_t var = 0; var < direction.size(); ++var) {
+            if (direction[var] == 0) { continue; }
+            std::unique_ptr<Expression> summand = model.gen_var_expr(var, model.get_variable(var));
+            if (direction[var] != 1) {
+                auto product = std::make_unique<BinaryOpExpression>(BinaryOpExpression::TIMES);
+                product->set_left(std::make_unique<IntegerValueExpression>(direction[var]));
+                product->set_right(std::move(summand));
+                summand = std::move(product);
+            }
+            if (not term) {
+                term = std::move(summand);
+                continue;
+            }
+            auto sum = std::make_unique<BinaryOpExpression>(BinaryOpExpression::PLUS);
+            sum->set_left(std::move(term));
+            sum->set_right(std::move(summand));
+            term = std::move(sum);
+        }
+        return term;
+    }
+}
+
+std::vector<TemplatePolyhedron::Direction> TemplatePolyhedron::octagon_directions(const size_t num_vars) {
+    std::vector<Direction> directions;
+    for (size_t i = 0; i < num_vars; ++i) {
+        Direction axis(num_vars, 0);
+        axis[i] = 1;
+        directions.push_back(std::move(axis));
+    }
+    for (size_t i = 0; i < num_vars; ++i) {
+        for (size_t j = i + 1; j < num_vars; ++j) {
+            Direction sum(num_vars, 0);
+            sum[i] = 1;
+            sum[j] = 1;
+            directions.push_back(std::move(sum));
+            Direction difference(num_vars, 0);
+            difference[i] = 1;
+            difference[j] = -1;
+            directions.push_back(std::move(difference));
+        }
+    }
+    return directions;
+}
+
+std::vector<TemplatePolyhedron::Direction> TemplatePolyhedron::principal_directions(
+    const std::vector<std::vector<int>>& points,
+    const size_t num_vars,
+    const int resolution) {
+    if (points.size() < 2) { return {}; }
+
+    // covariance matrix.
+    std::vector<double> mean(num_vars, 0);
+    for (const auto& point: points) {
+        for (size_t var = 0; var < num_vars; ++var) { mean[var] += point[var]; }
+    }
+    for (auto& value: mean) { value /= static_cast<double>(points.size()); }
+    std::vector<std::vector<double>> covariance(num_vars, std::vector<double>(num_vars, 0));
+    for (const auto& point: points) {
+        for (size_t i = 0; i < num_vars; ++i) {
+            for (size_t j = 0; j < num_vars; ++j) { covariance[i][j] += (point[i] - mean[i]) * (point[j] - mean[j]); }
+        }
+    }
+
+    // eigenvectors by power iteration with deflation.
+    std::vector<Direction> directions;
+    for (size_t component = 0; component < num_vars; ++component) {
+        std::vector<double> vector(num_vars, 1);
+        vector[component] += 1; // break symmetry.
+        double eigenvalue = 0;
+        for (int iteration = 0; iteration < power_iterations; ++iteration) {
+            std::vector<double> next(num_vars, 0);
+            for (size_t i = 0; i < num_vars; ++i) {
+                for (size_t j = 0; j < num_vars; ++j) { next[i] += covariance[i][j] * vector[j]; }
+            }
+            eigenvalue = std::sqrt(std::inner_product(next.begin(), next.end(), next.begin(), 0.0));
+            if (eigenvalue <= 0) { break; }
+            for (size_t i = 0; i < num_vars; ++i) { vector[i] = next[i] / eigenvalue; }
+        }
+        if (eigenvalue <= 0) { break; } // remaining variance is zero.
+        for (size_t i = 0; i < num_vars; ++i) {
+            for (size_t j = 0; j < num_vars; ++j) { covariance[i][j] -= eigenvalue * vector[i] * vector[j]; }
+        }
+
+        // round to integer coefficients.
+        const double max_abs = std::abs(*std::max_element(vector.begin(), vector.end(), [](double a, double b) {
+            return std::abs(a) < std::abs(b);
+        }));
+        Direction direction(num_vars);
+        int divisor = 0;
+        for (size_t var = 0; var < num_vars; ++var) {
+            direction[var] = static_cast<int>(std::lround(vector[var] / max_abs * resolution));
+            divisor = std::gcd(divisor, std::abs(direction[var]));
+        }
+        if (divisor == 0) { continue; }
+        for (auto& coefficient: direction) { coefficient /= divisor; }
+        directions.push_back(std::move(direction));
+    }
+    return directions;
+}
+
+std::pair<double, std::unique_ptr<Expression>> TemplatePolyhedron::compute(
+    const std::unordered_set<std::unique_ptr<StateBase>>& state_set,
+    const Model& model,
+    const std::vector<Direction>& directions) {
+    const auto& model_info = model.get_model_information();
+    const auto num_vars = static_cast<size_t>(model.get_number_variables());
+
+    const auto points = to_points(state_set, num_vars);
+
+    // tightest bounds per direction; drop directions that the domain bounds already imply.
+    std::vector<Constraint> constraints;
+    std::set<Direction> seen;
+    for (const auto& direction: directions) {
+        Direction negated(direction);
+        for (auto& coefficient: negated) { coefficient = -coefficient; }
+        if (not seen.insert(direction).second or seen.count(negated)) { continue; }
+
+        Constraint constraint { direction, std::numeric_limits<int64_t>::max(), std::numeric_limits<int64_t>::min() };
+        for (const auto& point: points) {
+            const auto value = dot(direction, point);
+            constraint.lower = std::min(constraint.lower, value);
+            constraint.upper = std::max(constraint.upper, value);
+        }
+        int64_t domain_lower = 0;
+        int64_t domain_upper = 0;
+        for (size_t var = 0; var < num_vars; ++var) {
+            const int64_t lb = model_info.get_lower_bound_int(var + 1);
+            const int64_t ub = model_info.get_upper_bound_int(var + 1);
+            domain_lower += std::min(direction[var] * lb, direction[var] * ub);
+            domain_upper += std::max(direction[var] * lb, direction[var] * ub);
+        }
+        if (constraint.lower <= domain_lower and constraint.upper >= domain_upper) { continue; }
+        constraints.push_back(std::move(constraint));
+    }
+
+    // relative size: exact within the bounding box if small, otherwise sampled.
+    std::vector<int> box_min(num_vars, INT_MAX);
+    std::vector<int> box_max(num_vars, INT_MIN);
+    for (const auto& point: points) {
+        for (size_t var = 0; var < num_vars; ++var) {
+            box_min[var] = std::min(box_min[var], point[var]);
+            box_max[var] = std::max(box_max[var], point[var]);
+        }
+    }
+    double box_size_rel = 1;
+    double box_volume = 1;
+    for (size_t var = 0; var < num_vars; ++var) {
+        const double var_dom = model_info.get_upper_bound_int(var + 1) - model_info.get_lower_bound_int(var + 1) + 1;
+        const double var_box = box_max[var] - box_min[var] + 1;
+        box_size_rel *= var_box / var_dom;
+        box_volume *= var_box;
+    }
+    size_t inside = 0;
+    size_t total = 0;
+    std::vector<int> point(box_min);
+    if (box_volume <= volume_samples) {
+        while (true) {
+            inside += satisfies(constraints, point);
+            ++total;
+            size_t var = num_vars;
+            while (var-- > 0) {
+                if (++point[var] <= box_max[var]) { break; }
+                point[var] = box_min[var];
+            }
+            if (var == static_cast<size_t>(-1)) { break; }
+        }
+    } else {
+        StartGenerator::RngStream rng(0, 0); // fixed stream: reproducible statistics.
+        for (; total < volume_samples; ++total) {
+            for (size_t var = 0; var < num_vars; ++var) {
+                point[var] = box_min[var] + static_cast<int>(rng.index(box_max[var] - box_min[var] + 1));
+            }
+            inside += satisfies(constraints, point);
+        }
+    }
+    const double size_rel = box_size_rel * static_cast<double>(inside) / static_cast<double>(total);
+    std::cout << "Polyhedron with " << constraints.size() << " constraints is ~" << std::fixed << std::setprecision(2)
+              << size_rel * 100 << "%" << " of state space" << std::endl;
+
+    // compute polyhedron expression
+    auto polyhedron = std::make_unique<NaryExpression>(BinaryOpExpression::AND);
+    for (const auto& constraint: constraints) {
+        auto term = to_linear_term(constraint.direction, model);
+        if (constraint.lower == constraint.upper) {
+            auto equal = std::make_unique<BinaryOpExpression>(BinaryOpExpression::EQ);
+            equal->set_left(std::move(term));
+            equal->set_right(std::make_unique<IntegerValueExpression>(constraint.lower));
+            polyhedron->add_sub(std::move(equal));
+            continue;
+        }
+        auto lower_bound = std::make_unique<BinaryOpExpression>(BinaryOpExpression::GE);
+        lower_bound->set_left(term->deepCopy_Exp());
+        lower_bound->set_right(std::make_unique<IntegerValueExpression>(constraint.lower));
+        polyhedron->add_sub(std::move(lower_bound));
+
+        auto upper_bound = std::make_unique<BinaryOpExpression>(BinaryOpExpression::LE);
+        upper_bound->set_left(std::move(term));
+        upper_bound->set_right(std::make_unique<IntegerValueExpression>(constraint.upper));
+        polyhedron->add_sub(std::move(upper_bound));
+    }
+    polyhedron->dump(true);
+    return std::make_pair(size_rel, std::move(polyhedron));
+}
+
+std::pair<double, std::unique_ptr<Expression>> TemplatePolyhedron::compute_octagon(
+    const std::unordered_set<std::unique_ptr<StateBase>>& state_set,
+    const Model& model) {
+    std::cout << "Computing octagon ..." << '\n';
+    return compute(state_set, model, octagon_directions(model.get_number_variables()));
+}
+
+std::pair<double, std::unique_ptr<Expression>> TemplatePolyhedron::compute_hull(
+    const std::unordered_set<std::unique_ptr<StateBase>>& state_set,
+    const Model& model) {
+    std::cout << "Computing template hull ..." << '\n';
+    const auto num_vars = static_cast<size_t>(model.get_number_variables());
+    auto directions = octagon_directions(num_vars);
+    for (auto& direction: principal_directions(to_points(state_set, num_vars), num_vars)) {
+        directions.push_back(std::move(direction));
+    }
+    return compute(state_set, model, directions);
+}
@@ -0,0 +1,48 @@
+//
+// Created by Daniel Sherbakov in 2025.
+//
+
+#ifndef TEMPLATE_POLYHEDRON_H
+#define TEMPLATE_POLYHEDRON_H
+#include "../../fd_adaptions/state.h"
+
+/**
+ * Computes an overapproximation of a set of states by a template polyhedron, i.e., the tightest polyhedron whose facets
+ * have the given (integer) normal directions. For each direction d, the polyhedron bounds d·x by the minimum and
+ * maximum over all states.
+ *
+ * - Octagon: the axes and all directions x_i + x_j and x_i - x_j.
+ * - Hull: the octagon directions plus the principal axes of the state set, rounded to small integer coefficients.
+ *   It approaches the convex hull for diagonal or rotated sets, which neither boxes nor octagons capture.
+ */
+class TemplatePolyhedron {
+public:
+    using Direction = std::vector<int>; // coefficient per model variable (excluding loc).
+
+    static std::pair<double, std::unique_ptr<Expression>> compute_octagon(
+        const std::unordered_set<std::unique_ptr<StateBase>>& state_set,
+        const Model& model);
+
+    static std::pair<double, std::unique_ptr<Expression>> compute_hull(
+        const std::unordered_set<std::unique_ptr<StateBase>>& state_set,
+        const Model& model);
+
+    /**
+     * @return relative size of the polyhedron w.r.t. the state space (estimated by sampling for large boxes), and the
+     * conjunction of its non-redundant linear constraints.
+     */
+    static std::pair<double, std::unique_ptr<Expression>> compute(
+        const std::unordered_set<std::unique_ptr<StateBase>>& state_set,
+        const Model& model,
+        const std::vector<Direction>& directions);
+
+    static std::vector<Direction> octagon_directions(size_t num_vars);
+
+    /// @return principal axes of the point cloud, scaled to coefficients in [-resolution, resolution].
+    static std::vector<Direction> principal_directions(
+        const std::vector<std::vector<int>>& points,
+        size_t num_vars,
+        int resolution = 4);
+};
+
+#endif //TEMPLATE_POLYHEDRON_H
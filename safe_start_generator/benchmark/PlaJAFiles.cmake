@@ -0,0 +1,35 @@
+# Benchmark executable for the safe start generator components.
+# Kept apart from SAFE_START_GENERATOR_SOURCES so that it is not linked into the PlaJA binary.
+set(SAFE_START_GENERATOR_BENCHMARK_SOURCES
+        ${CMAKE_CURRENT_LIST_DIR}/safe_start_benchmark.cpp
+        ${CMAKE_CURRENT_LIST_DIR}/synthetic_model.h
+        ${CMAKE_CURRENT_LIST_DIR}/synthetic_model.cpp
+)
+
+option(BUILD_SAFE_START_BENCHMARK "Build the safe start generator benchmark executable." OFF)
+
+set(SAFE_START_BENCHMARK_PLAJA_LIBRARY "PlaJA_lib" CACHE STRING
+        "PlaJA library target the safe start generator benchmark links against.")
+
+macro(add_safe_start_benchmark plaja_library)
+    if (BUILD_SAFE_START_BENCHMARK AND NOT TARGET safe_start_benchmark)
+        add_executable(safe_start_benchmark ${SAFE_START_GENERATOR_BENCHMARK_SOURCES})
+        target_link_libraries(safe_start_benchmark PRIVATE ${plaja_library})
+    endif ()
+endmacro()
+
+# Deferred to the end of the including directory (see ../PlaJAFiles.cmake), where the PlaJA library target exists.
+function(add_safe_start_benchmark_if_available)
+    if (NOT TARGET ${SAFE_START_BENCHMARK_PLAJA_LIBRARY})
+        message(WARNING "safe_start_benchmark not built: no target ${SAFE_START_BENCHMARK_PLAJA_LIBRARY}, "
+                "set SAFE_START_BENCHMARK_PLAJA_LIBRARY to the PlaJA library target.")
+        return()
+    endif ()
+    get_target_property(plaja_library_type ${SAFE_START_BENCHMARK_PLAJA_LIBRARY} TYPE)
+    if (plaja_library_type STREQUAL "EXECUTABLE")
+        message(WARNING "safe_start_benchmark not built: ${SAFE_START_BENCHMARK_PLAJA_LIBRARY} is an executable, "
+                "set SAFE_START_BENCHMARK_PLAJA_LIBRARY to the PlaJA library target.")
+        return()
+    endif ()
+    add_safe_start_benchmark(${SAFE_START_BENCHMARK_PLAJA_LIBRARY})
+endfunction()
@@ -0,0 +1,212 @@
+//
+// Created by Daniel Sherbakov in 2025.
+//
+
+/**
+ * Microbenchmarks for the safe start generator components on synthetic models.
+ *
+ * Usage: safe_start_benchmark [repetitions] [seed]
+ *
+ * Prints one CSV row per configuration: component, number of variables, state-set size, condition size (conjuncts),
+ * mean wall time per run in milliseconds and throughput (states/s for approximations and refinement, steps/s for testing).
+ */
+
+#include "../../../globals.h"
+#include "../../../parser/ast/expression/expression.h"
+#include "../../../utils/rng.h"
+#include "../../factories/configuration.h"
+#include "../../non_prob_search/initial_states_enumerator.h"
+#include "../../stats/stats_base.h"
+#include "../../successor_generation/simulation_environment.h"
+#include "../approximation_methods/bounded_box.h"
+#include "../approximation_methods/bounding_box.h"
+#include "../start_generation_statistics.h"
+#include "../strengthening_strategy/junction_condition.h"
+#include "../strengthening_strategy/strengthening_strategy.h"
+#include "../testing/unsafe_path_identifier.h"
+#include "../verification_methods/verification_types.h"
+#include "synthetic_model.h"
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace {
+
+    const std::vector<int> var_sizes { 2, 4, 8 };
+    const std::vector<std::size_t> state_set_sizes { 100, 1000, 10000 };
+    const std::vector<std::size_t> bounded_box_set_sizes { 50, 200, 800 }; // bounded box is exponential in dimension.
+    const std::vector<std::size_t> condition_sizes { 10, 100, 1000 };
+    constexpr int domain_size = 32;
+    constexpr int testing_seconds = 1;
+
+    /// @return mean wall time in milliseconds over `repetitions` runs of `run`; `setup` is excluded from timing.
+    double measure(const int repetitions, const std::function<void()>& setup, const std::function<void()>& run) {
+        double total_ms = 0;
+        for (int rep = 0; rep < repetitions; ++rep) {
+            setup();
+            const auto start = std::chrono::steady_clock::now();
+            run();
+            const auto end = std::chrono::steady_clock::now();
+            total_ms += std::chrono::duration<double, std::milli>(end - start).count();
+        }
+        return total_ms / repetitions;
+    }
+
+    void print_row(
+        const std::string& component,
+        const int vars,
+        const std::size_t states,
+        const std::size_t conditions,
+        const double mean_ms,
+        const double throughput) {
+        std::cout << component << ',' << vars << ',' << states << ',' << conditions << ',' << mean_ms << ','
+                  << throughput << '\n';
+    }
+
+    void bench_bounding_box(const SyntheticModel& synthetic, const int repetitions) {
+        for (const auto num_states: state_set_sizes) {
+            const auto states = synthetic.sample_states(num_states, 0.5);
+            const double ms =
+                measure(repetitions, [] {}, [&] { BoundingBox::compute_bounding_box(states, synthetic.get_model()); });
+            print_row("BoundingBox", synthetic.get_num_vars(), num_states, 0, ms, num_states / ms * 1000);
+            // the bounds are accumulated while the unsafe states are collected, only the box is built at refinement.
+            StartGenerator::BoxAccumulator bounds(synthetic.get_model());
+            const double incremental_ms = measure(
+                repetitions,
+                [&] { bounds.clear(); },
+                [&] {
+                    for (const auto& state: states) { bounds.add(*state); }
+                    BoundingBox::compute_bounding_box(bounds, synthetic.get_model());
+                });
+            print_row(
+                "BoundingBoxIncremental",
+                synthetic.get_num_vars(),
+                num_states,
+                0,
+                incremental_ms,
+                num_states / incremental_ms * 1000);
+            // the share of the refinement, the accumulation is paid while the unsafe states are collected.
+            const double construction_ms =
+                measure(repetitions, [] {}, [&] { BoundingBox::compute_bounding_box(bounds, synthetic.get_model()); });
+            print_row(
+                "BoundingBoxConstructionOnly",
+                synthetic.get_num_vars(),
+                num_states,
+                0,
+                construction_ms,
+                num_states / construction_ms * 1000);
+        }
+    }
+
+    void bench_bounded_box(const SyntheticModel& synthetic, const int repetitions) {
+        for (const auto num_states: bounded_box_set_sizes) {
+            const auto states = synthetic.sample_states(num_states, 0.8);
+            const double ms =
+                measure(repetitions, [] {}, [&] { BoundedBox::compute_bounded_box(states, synthetic.get_model()); });
+            print_row("BoundedBox", synthetic.get_num_vars(), num_states, 0, ms, num_states / ms * 1000);
+        }
+    }
+
+    void bench_update_conditions(
+        const SyntheticModel& synthetic,
+        const VerificationMethods::Type type,
+        const int repetitions) {
+        const auto strategy =
+            StrengtheningStrategy::create(type, synthetic.get_model(), Approximation::Type::None, nullptr);
+        const std::string name = "UpdateConditions_" + VerificationMethods::type_to_string(type);
+        for (const auto num_conditions: condition_sizes) {
+            for (const auto num_states: { std::size_t(10), std::size_t(100) }) {
+                std::unordered_set<std::unique_ptr<StateBase>> unsafe_states;
+                std::unique_ptr<StartGenerator::JunctionCondition> start;
+                std::unique_ptr<StartGenerator::JunctionCondition> unsafety;
+                const double ms = measure(
+                    repetitions,
+                    [&] {
+                        unsafe_states = synthetic.sample_states(num_states, 0);
+                        start = std::make_unique<StartGenerator::JunctionCondition>(
+                            synthetic.start_condition(num_conditions),
+                            StartGenerator::JunctionCondition::Junction::Conjunction);
+                        unsafety = std::make_unique<StartGenerator::JunctionCondition>(
+                            synthetic.unsafety_condition(),
+                            StartGenerator::JunctionCondition::Junction::Disjunction);
+                    },
+                    [&] { strategy->update_conditions(*start, *unsafety, false, unsafe_states, nullptr); });
+                print_row(name, synthetic.get_num_vars(), num_states, num_conditions, ms, num_states / ms * 1000);
+            }
+        }
+    }
+
+    void bench_unsafe_path_identifier(const SyntheticModel& synthetic, const uint64_t seed) {
+        const auto& config = synthetic.get_config();
+        SimulationEnvironment sim_env(config, synthetic.get_model());
+        StartGenerator::SuccessorCache successor_cache(sim_env);
+        const SyntheticPolicy synthetic_policy(synthetic);
+        StartGenerator::PolicyCache policy(synthetic_policy);
+        PLAJA::StatsBase stats;
+        StartGenerationStatistics::add_basic_stats(stats);
+        const auto unsafety = synthetic.unsafety_condition();
+        const StartGenerator::RngStreamFactory rng_streams(seed); // family 0 samples starts, 1 tests.
+        StartGenerator::PolicyEnvelope envelope;
+        for (const auto num_conditions: condition_sizes) {
+            const auto start = synthetic.start_condition(num_conditions);
+            InitialStatesEnumerator enumerator(config, *start);
+            // uniform, no counterexamples are seeded.
+            StartGenerator::StartSampler start_sampler(
+                enumerator,
+                synthetic.get_model(),
+                *start,
+                0,
+                0,
+                rng_streams.derive(0).stream(num_conditions));
+            UnsafePathIdentifier identifier(
+                config,
+                StartGenerator::Deadline(testing_seconds),
+                sim_env,
+                successor_cache,
+                policy,
+                *start,
+                *unsafety,
+                &start_sampler,
+                rng_streams.derive(1).derive(num_conditions),
+                envelope,
+                nullptr,
+                stats,
+                nullptr,
+                true,
+                false);
+            const auto begin = std::chrono::steady_clock::now();
+            identifier.identify_unsafe_paths();
+            const auto end = std::chrono::steady_clock::now();
+            const double ms = std::chrono::duration<double, std::milli>(end - begin).count();
+            print_row(
+                "UnsafePathIdentifier",
+                synthetic.get_num_vars(),
+                0,
+                num_conditions,
+                ms,
+                static_cast<double>(identifier.get_num_steps()) / ms * 1000);
+        }
+    }
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const int repetitions = argc > 1 ? std::stoi(argv[1]) : 5;
+    const uint64_t seed = argc > 2 ? std::stoull(argv[2]) : 0;
+    // sampled state sets and start states are drawn from the global rng.
+    PLAJA_GLOBAL::rng = std::make_unique<RandomNumberGenerator>(seed);
+    std::cout << "Component,Vars,States,Conditions,MeanMs,Throughput" << '\n';
+    for (const auto vars: var_sizes) {
+        const SyntheticModel synthetic(vars, domain_size);
+        bench_bounding_box(synthetic, repetitions);
+        if (vars <= 4) { bench_bounded_box(synthetic, repetitions); }
+        bench_update_conditions(synthetic, VerificationMethods::Type::INVARIANT_STRENGTHENING, repetitions);
+        bench_update_conditions(synthetic, VerificationMethods::Type::START_CONDITION_STRENGTHENING, repetitions);
+        bench_unsafe_path_identifier(synthetic, seed);
+    }
+    return 0;
+}
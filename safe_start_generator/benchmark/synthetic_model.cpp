@@ -0,0 +1,145 @@
+//
+// Created by Daniel Sherbakov in 2025.
+//
+
+#include "synthetic_model.h"
+
+#include "../../../globals.h"
+#include "../../../parser/ast/expression/binary_op_expression.h"
+#include "../../../parser/ast/expression/integer_value_expression.h"
+#include "../../../parser/ast/expression/special_cases/nary_expression.h"
+#include "../../../parser/ast/model.h"
+#include "../../../parser/parser.h"
+#include "../../../parser/visitor/to_normalform.h"
+#include "../../../utils/rng.h"
+#include "../../factories/configuration.h"
+#include "../../fd_adaptions/state.h"
+#include "../../information/model_information.h"
+#include "../../states/state_values.h"
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <set>
+#include <sstream>
+
+SyntheticModel::SyntheticModel(const int num_vars, const int domain_size):
+    num_vars(num_vars),
+    domain_size(domain_size),
+    jani_file((std::filesystem::temp_directory_path() /
+               ("synthetic_" + std::to_string(num_vars) + "_" + std::to_string(domain_size) + ".jani"))
+                  .string()),
+    config(std::make_unique<PLAJA::Configuration>()) {
+    std::ofstream file(jani_file);
+    file << to_jani();
+    file.close();
+    model = Parser().parse_model_file(jani_file);
+    PLAJA_GLOBAL::currentModel = model.get();
+    first_var_index = model->get_model_information().get_number_automata_instances();
+}
+
+SyntheticModel::~SyntheticModel() { std::filesystem::remove(jani_file); }
+
+std::string SyntheticModel::to_jani() const {
+    const int ub = domain_size - 1;
+    std::stringstream jani;
+    jani << R"({"jani-version": 1, "name": "synthetic_grid", "type": "lts", "features": [], "actions": [)";
+    for (int i = 0; i < num_vars; ++i) {
+        jani << (i ? ", " : "") << R"({"name": "inc_)" << i << R"("}, {"name": "dec_)" << i << R"("})";
+    }
+    jani << R"(], "variables": [)";
+    for (int i = 0; i < num_vars; ++i) {
+        jani << (i ? ", " : "") << R"({"name": "x)" << i
+             << R"(", "type": {"kind": "bounded", "base": "int", "lower-bound": 0, "upper-bound": )" << ub
+             << R"(}, "initial-value": 0})";
+    }
+    jani << R"(], "properties": [], "automata": [{"name": "grid", "locations": [{"name": "l"}], )"
+         << R"("initial-locations": ["l"], "edges": [)";
+    for (int i = 0; i < num_vars; ++i) {
+        const std::string var = "x" + std::to_string(i);
+        // increment by one or (non-deterministically) by two.
+        for (int step = 1; step <= 2; ++step) {
+            jani << (i or step > 1 ? ", " : "") << R"({"location": "l", "action": "inc_)" << i
+                 << R"(", "guard": {"exp": {"op": "<=", "left": ")" << var << R"(", "right": )" << ub - step
+                 << R"(}}, "destinations": [{"location": "l", "assignments": [{"ref": ")" << var
+                 << R"(", "value": {"op": "+", "left": ")" << var << R"(", "right": )" << step << R"(}}]}]})";
+        }
+        jani << R"(, {"location": "l", "action": "dec_)" << i << R"(", "guard": {"exp": {"op": ">", "left": ")"
+             << var << R"(", "right": 0}}, "destinations": [{"location": "l", "assignments": [{"ref": ")" << var
+             << R"(", "value": {"op": "-", "left": ")" << var << R"(", "right": 1}}]}]})";
+    }
+    jani << R"(]}], "system": {"elements": [{"automaton": "grid"}], "syncs": [)";
+    for (int i = 0; i < num_vars; ++i) {
+        jani << (i ? ", " : "") << R"({"synchronise": ["inc_)" << i << R"("], "result": "inc_)" << i << R"("}, )"
+             << R"({"synchronise": ["dec_)" << i << R"("], "result": "dec_)" << i << R"("})";
+    }
+    jani << "]}}";
+    return jani.str();
+}
+
+std::unique_ptr<StateBase> SyntheticModel::to_state(const std::vector<int>& valuation) const {
+    auto state = model->get_model_information().get_initial_values();
+    for (int i = 0; i < num_vars; ++i) { state.assign_int<false>(first_var_index + i, valuation[i]); }
+    return state.to_ptr();
+}
+
+std::unordered_set<std::unique_ptr<StateBase>> SyntheticModel::sample_states(
+    const std::size_t num_states,
+    const double cluster_fraction) const {
+    std::set<std::vector<int>> valuations;
+    const auto cluster_states = static_cast<std::size_t>(cluster_fraction * static_cast<double>(num_states));
+    const int cluster_width = std::max(2, domain_size / 4);
+    while (valuations.size() < num_states) {
+        const bool in_cluster = valuations.size() < cluster_states;
+        std::vector<int> valuation(num_vars);
+        for (auto& value: valuation) {
+            value = in_cluster ? domain_size - 1 - static_cast<int>(PLAJA_GLOBAL::rng->index(cluster_width))
+                               : static_cast<int>(PLAJA_GLOBAL::rng->index(domain_size));
+        }
+        valuations.insert(std::move(valuation));
+    }
+    std::unordered_set<std::unique_ptr<StateBase>> states;
+    for (const auto& valuation: valuations) { states.emplace(to_state(valuation)); }
+    return states;
+}
+
+std::unique_ptr<Expression> SyntheticModel::unsafety_condition() const {
+    auto unsafety = std::make_unique<BinaryOpExpression>(BinaryOpExpression::GE);
+    unsafety->set_left(model->gen_var_expr(0, model->get_variable(0)));
+    unsafety->set_right(std::make_unique<IntegerValueExpression>(domain_size - 2));
+    return unsafety;
+}
+
+std::unique_ptr<Expression> SyntheticModel::start_condition(const std::size_t num_excluded) const {
+    auto start = std::make_unique<NaryExpression>(BinaryOpExpression::AND);
+    for (int var_index = 0; var_index < num_vars; ++var_index) {
+        auto var_expr = model->gen_var_expr(var_index, model->get_variable(var_index));
+        auto lower = std::make_unique<BinaryOpExpression>(BinaryOpExpression::GE);
+        lower->set_left(var_expr->deepCopy_Exp());
+        lower->set_right(std::make_unique<IntegerValueExpression>(0));
+        start->add_sub(std::move(lower));
+        auto upper = std::make_unique<BinaryOpExpression>(BinaryOpExpression::LE);
+        upper->set_left(std::move(var_expr));
+        upper->set_right(std::make_unique<IntegerValueExpression>(domain_size - 1));
+        start->add_sub(std::move(upper));
+    }
+    for (const auto& state: sample_states(num_excluded, 0)) {
+        auto excluded = state->to_condition(false, *model);
+        TO_NORMALFORM::negate(excluded);
+        start->add_sub(std::move(excluded));
+    }
+    return start;
+}
+
+SyntheticPolicy::SyntheticPolicy(const SyntheticModel& model):
+    num_vars(model.get_num_vars()),
+    domain_size(model.get_domain_size()),
+    first_var_index(model.get_first_var_index()) {}
+
+ActionLabel_type SyntheticPolicy::evaluate(const State& state) const {
+    int sum = 0;
+    for (int i = 0; i < num_vars; ++i) { sum += state.get_int(first_var_index + i); }
+    const int var = sum % num_vars;
+    const bool at_bound = state.get_int(first_var_index + var) >= domain_size - 2;
+    return 2 * var + (at_bound ? 1 : 0); // actions are ordered inc_0, dec_0, inc_1, ...
+}
@@ -0,0 +1,86 @@
+//
+// Created by Daniel Sherbakov in 2025.
+//
+
+#ifndef SYNTHETIC_MODEL_H
+#define SYNTHETIC_MODEL_H
+
+#include "../../../utils/default_constructors.h"
+#include "../../non_prob_search/policy/policy.h"
+#include "../../states/forward_states.h"
+#include "../../using_search.h"
+
+#include <memory>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+namespace PLAJA {
+    class Configuration;
+}
+class Expression;
+class Model;
+
+/**
+ * @brief Synthetic grid model used as offline benchmark input.
+ *
+ * The model has `num_vars` bounded integer variables with domain [0, domain_size - 1].
+ * For each variable there is an increment action, which non-deterministically moves by one or two, and a decrement action.
+ * The model is generated as JANI file and loaded through the PlaJA parser, so all components run on a regular `Model`.
+ */
+class SyntheticModel {
+public:
+    SyntheticModel(int num_vars, int domain_size);
+    ~SyntheticModel();
+    DELETE_CONSTRUCTOR(SyntheticModel)
+
+    [[nodiscard]] const Model& get_model() const { return *model; }
+    [[nodiscard]] const PLAJA::Configuration& get_config() const { return *config; }
+    [[nodiscard]] int get_num_vars() const { return num_vars; }
+    [[nodiscard]] int get_domain_size() const { return domain_size; }
+    /// @return state index of variable x_0, the variables follow consecutively after the locations.
+    [[nodiscard]] VariableIndex_type get_first_var_index() const { return first_var_index; }
+
+    /**
+     * @brief samples a set of distinct states.
+     *
+     * A fraction of the states is drawn from a dense cluster in the upper corner of the domain, the rest uniformly.
+     * The cluster gives the bounded box approximation a non-trivial box to find.
+     */
+    [[nodiscard]] std::unordered_set<std::unique_ptr<StateBase>> sample_states(
+        std::size_t num_states,
+        double cluster_fraction) const;
+
+    /// @return x_0 >= domain_size - 2.
+    [[nodiscard]] std::unique_ptr<Expression> unsafety_condition() const;
+    /// @return domain bounds conjoined with `num_excluded` negated random states (a start condition after refinement).
+    [[nodiscard]] std::unique_ptr<Expression> start_condition(std::size_t num_excluded) const;
+
+private:
+    const int num_vars;
+    const int domain_size;
+    std::string jani_file;
+    std::unique_ptr<Model> model;
+    std::unique_ptr<PLAJA::Configuration> config;
+    VariableIndex_type first_var_index = 0;
+
+    [[nodiscard]] std::string to_jani() const;
+    [[nodiscard]] std::unique_ptr<StateBase> to_state(const std::vector<int>& valuation) const;
+};
+
+/**
+ * Deterministic stand-in for a NN policy: increments the variable selected by the sum of the state values,
+ * or decrements it if it is at its upper bound.
+ */
+class SyntheticPolicy final: public Policy {
+public:
+    explicit SyntheticPolicy(const SyntheticModel& model);
+    [[nodiscard]] ActionLabel_type evaluate(const State& state) const override;
+
+private:
+    const int num_vars;
+    const int domain_size;
+    const VariableIndex_type first_var_index;
+};
+
+#endif //SYNTHETIC_MODEL_H
@@ -0,0 +1,80 @@
+//
+// Created by Daniel Sherbakov in 2025.
+//
+
+#ifndef DEADLINE_H
+#define DEADLINE_H
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <limits>
+#include <memory>
+#include <optional>
+
+namespace StartGenerator {
+
+    /**
+     * @brief Point in time by which a phase of the generator has to finish.
+     *
+     * The generator derives one deadline from the overall time limit and hands it (or a tighter one, see `limit`) to
+     * every phase. Phases poll it at their natural cancellation points, e.g., before each trajectory or solver query,
+     * and return what they have found so far once it expired.
+     * A cancellable deadline additionally expires once any of its copies is cancelled, e.g., by a competing thread.
+     */
+    class Deadline {
+    public:
+        using Clock = std::chrono::steady_clock;
+
+        /// unbounded deadline.
+        Deadline() = default;
+
+        /// deadline in the given number of seconds from now, unbounded if seconds is not positive or not finite.
+        explicit Deadline(const double seconds) {
+            // the conversion to clock ticks overflows far below the largest double.
+            if (seconds > 0 and seconds < max_seconds) {
+                end = Clock::now() + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(seconds));
+            }
+        }
+
+        [[nodiscard]] bool is_bounded() const { return end.has_value(); }
+        [[nodiscard]] bool is_expired() const {
+            return (cancelled and cancelled->load(std::memory_order_relaxed)) or (end and Clock::now() >= *end);
+        }
+
+        /// @return seconds until expiry (at least 0), infinity if unbounded.
+        [[nodiscard]] double remaining() const {
+            if (not end) { return std::numeric_limits<double>::infinity(); }
+            return std::max(0.0, std::chrono::duration<double>(*end - Clock::now()).count());
+        }
+
+        /// @return the earlier of this deadline and the given number of seconds from now, e.g., for a phase time limit.
+        [[nodiscard]] Deadline limit(const double seconds) const {
+            const Deadline phase(seconds);
+            Deadline result(*this);
+            if (phase.end) { result.end = end ? std::min(*end, *phase.end) : *phase.end; }
+            return result;
+        }
+
+        /// @return copy of this deadline with a fresh cancellation flag shared by all of its copies.
+        [[nodiscard]] Deadline cancellable() const {
+            Deadline result(*this);
+            result.cancelled = std::make_shared<std::atomic<bool>>(false);
+            return result;
+        }
+
+        /// expires this deadline and all of its copies; no-op if not cancellable.
+        void cancel() const {
+            if (cancelled) { cancelled->store(true, std::memory_order_relaxed); }
+        }
+
+    private:
+        static constexpr double max_seconds = 1e9; // about 30 years, beyond is unbounded in practice.
+
+        std::optional<Clock::time_point> end;
+        std::shared_ptr<std::atomic<bool>> cancelled; // null if not cancellable.
+    };
+
+} // namespace StartGenerator
+
+#endif //DEADLINE_H
@@ -0,0 +1,6 @@
+set(DECISION_DIAGRAMS_SOURCES
+        ${CMAKE_CURRENT_LIST_DIR}/interval_diagram.h
+        ${CMAKE_CURRENT_LIST_DIR}/interval_diagram.cpp
+        ${CMAKE_CURRENT_LIST_DIR}/condition_diagrams.h
+        ${CMAKE_CURRENT_LIST_DIR}/condition_diagrams.cpp
+)
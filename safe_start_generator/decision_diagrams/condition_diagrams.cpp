@@ -0,0 +1,190 @@
+//
+// Created by Daniel Sherbakov in 2025.
+//
+
+#include "condition_diagrams.h"
+
+#include "../../../assertions.h"
+#include "../../../parser/ast/expression/binary_op_expression.h"
+#include "../../../parser/ast/expression/bool_value_expression.h"
+#include "../../../parser/ast/expression/integer_value_expression.h"
+#include "../../../parser/ast/expression/special_cases/nary_expression.h"
+#include "../../../parser/ast/model.h"
+#include "../../../parser/ast/variable_declaration.h"
+#include "../../information/model_information.h"
+#include "../../states/state_base.h"
+#include "../../states/state_values.h"
+#include "../state_valuation.h"
+
+#include <algorithm>
+#include <iostream>
+
+namespace {
+
+    std::vector<int> lower_bounds(const Model& model) {
+        std::vector<int> bounds;
+        for (int var = 1; var <= model.get_number_variables(); ++var) {
+            bounds.push_back(model.get_model_information().get_lower_bound_int(var));
+        }
+        return bounds;
+    }
+
+    std::vector<int> upper_bounds(const Model& model) {
+        std::vector<int> bounds;
+        for (int var = 1; var <= model.get_number_variables(); ++var) {
+            bounds.push_back(model.get_model_information().get_upper_bound_int(var));
+        }
+        return bounds;
+    }
+
+    /// @return the diagram of the condition, enumerating the whole domain.
+    StartGenerator::IntervalDiagram::Node build(
+        StartGenerator::IntervalDiagram& diagram,
+        const Model& model,
+        const Expression& condition) {
+        auto probe = model.get_model_information().get_initial_values();
+        return diagram.from_predicate([&](const std::vector<int>& values) {
+            for (std::size_t var = 0; var < values.size(); ++var) { probe.assign_int<false>(var + 1, values[var]); }
+            return static_cast<bool>(condition.evaluate_integer(probe));
+        });
+    }
+
+} // namespace
+
+namespace StartGenerator {
+
+    ConditionDiagrams::ConditionDiagrams(
+        const Model& model,
+        const Expression& start_condition,
+        const Expression& unsafety_condition):
+        model(model),
+        diagram(lower_bounds(model), upper_bounds(model)),
+        start(build(diagram, model, start_condition)),
+        unsafety(build(diagram, model, unsafety_condition)) {
+        std::cout << "Decision diagrams: " << diagram.count(start) << " start states, " << diagram.count(unsafety)
+                  << " unsafe states, " << diagram.num_nodes() << " nodes." << '\n';
+    }
+
+    ConditionDiagrams::~ConditionDiagrams() = default;
+
+    std::unique_ptr<ConditionDiagrams> ConditionDiagrams::create(
+        const Model& model,
+        const Expression& start_condition,
+        const Expression& unsafety_condition,
+        const uint64_t max_domain_size) {
+        const auto lower = lower_bounds(model);
+        const auto upper = upper_bounds(model);
+        uint64_t domain_size = 1;
+        for (std::size_t var = 0; var < lower.size(); ++var) {
+            const auto var_size = static_cast<uint64_t>(static_cast<int64_t>(upper[var]) - lower[var] + 1);
+            if (domain_size > max_domain_size / var_size) {
+                PLAJA_LOG("Domain too large for decision diagrams, using expressions only.")
+                return nullptr;
+            }
+            domain_size *= var_size;
+        }
+        return std::make_unique<ConditionDiagrams>(model, start_condition, unsafety_condition);
+    }
+
+    std::vector<int> ConditionDiagrams::to_values(const StateBase& state) {
+        auto values = to_valuation(state);
+        values.erase(values.begin()); // location variable.
+        return values;
+    }
+
+    void ConditionDiagrams::add_unsafe_state(const StateBase& state) {
+        const auto excluded = diagram.point(to_values(state));
+        start = diagram.subtract(start, excluded);
+        unsafety = diagram.unite(unsafety, excluded);
+    }
+
+    void ConditionDiagrams::add_unsafe_states(const std::unordered_set<std::unique_ptr<StateBase>>& states) {
+        auto excluded = IntervalDiagram::empty;
+        for (const auto& state: states) { excluded = diagram.unite(excluded, diagram.point(to_values(*state))); }
+        start = diagram.subtract(start, excluded);
+        unsafety = diagram.unite(unsafety, excluded);
+    }
+
+    void ConditionDiagrams::add_unsafe_box(const std::vector<int>& min_corner, const std::vector<int>& max_corner) {
+        PLAJA_ASSERT(min_corner.size() == static_cast<std::size_t>(model.get_number_variables()))
+        const auto excluded = diagram.cube({ min_corner, max_corner });
+        start = diagram.subtract(start, excluded);
+        unsafety = diagram.unite(unsafety, excluded);
+    }
+
+    void ConditionDiagrams::add_unsafe_region(
+        const Expression& region,
+        const std::unordered_set<std::unique_ptr<StateBase>>& states) {
+        if (states.empty()) { return; }
+        IntervalDiagram::Cube bounding_box { to_values(**states.begin()), to_values(**states.begin()) };
+        for (const auto& state: states) {
+            const auto values = to_values(*state);
+            for (std::size_t var = 0; var < values.size(); ++var) {
+                bounding_box.lower[var] = std::min(bounding_box.lower[var], values[var]);
+                bounding_box.upper[var] = std::max(bounding_box.upper[var], values[var]);
+            }
+        }
+        auto probe = model.get_model_information().get_initial_values();
+        const auto excluded = diagram.from_predicate(
+            [&](const std::vector<int>& values) {
+                for (std::size_t var = 0; var < values.size(); ++var) { probe.assign_int<false>(var + 1, values[var]); }
+                return static_cast<bool>(region.evaluate_integer(probe));
+            },
+            bounding_box);
+        start = diagram.subtract(start, excluded);
+        unsafety = diagram.unite(unsafety, excluded);
+    }
+
+    std::unique_ptr<StateBase> ConditionDiagrams::sample_start(RngStream& rng) {
+        if (is_start_empty()) { return nullptr; }
+        const auto values = diagram.sample(start, rng);
+        auto state = model.get_model_information().get_initial_values();
+        for (std::size_t var = 0; var < values.size(); ++var) { state.assign_int<false>(var + 1, values[var]); }
+        return state.to_ptr();
+    }
+
+    std::unique_ptr<Expression> ConditionDiagrams::to_expression(const IntervalDiagram::Node node) const {
+        const auto& model_info = model.get_model_information();
+        auto disjunction = std::make_unique<NaryExpression>(BinaryOpExpression::OR);
+        std::size_t num_cubes = 0;
+        for (const auto& cube: diagram.to_cubes(node)) {
+            auto conjunction = std::make_unique<NaryExpression>(BinaryOpExpression::AND);
+            std::size_t num_bounds = 0;
+            for (std::size_t var = 0; var < cube.lower.size(); ++var) {
+                const auto state_index = static_cast<VariableIndex_type>(var + 1);
+                const bool has_lower = cube.lower[var] > model_info.get_lower_bound_int(state_index);
+                const bool has_upper = cube.upper[var] < model_info.get_upper_bound_int(state_index);
+                if (not has_lower and not has_upper) { continue; }
+                auto var_expr = model.gen_var_expr(var, model.get_variable(var));
+                if (cube.lower[var] == cube.upper[var]) {
+                    auto equal = std::make_unique<BinaryOpExpression>(BinaryOpExpression::EQ);
+                    equal->set_left(std::move(var_expr));
+                    equal->set_right(std::make_unique<IntegerValueExpression>(cube.lower[var]));
+                    conjunction->add_sub(std::move(equal));
+                    ++num_bounds;
+                    continue;
+                }
+                if (has_lower) {
+                    auto lower = std::make_unique<BinaryOpExpression>(BinaryOpExpression::GE);
+                    lower->set_left(var_expr->deepCopy_Exp());
+                    lower->set_right(std::make_unique<IntegerValueExpression>(cube.lower[var]));
+                    conjunction->add_sub(std::move(lower));
+                    ++num_bounds;
+                }
+                if (has_upper) {
+                    auto upper = std::make_unique<BinaryOpExpression>(BinaryOpExpression::LE);
+                    upper->set_left(std::move(var_expr));
+                    upper->set_right(std::make_unique<IntegerValueExpression>(cube.upper[var]));
+                    conjunction->add_sub(std::move(upper));
+                    ++num_bounds;
+                }
+            }
+            if (num_bounds == 0) { return std::make_unique<BoolValueExpression>(true); } // whole domain.
+            disjunction->add_sub(std::move(conjunction));
+            ++num_cubes;
+        }
+        if (num_cubes == 0) { return std::make_unique<BoolValueExpression>(false); }
+        return disjunction;
+    }
+
+} // namespace StartGenerator
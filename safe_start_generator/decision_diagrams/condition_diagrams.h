@@ -0,0 +1,87 @@
+//
+// Created by Daniel Sherbakov in 2025.
+//
+
+#ifndef CONDITION_DIAGRAMS_H
+#define CONDITION_DIAGRAMS_H
+
+#include "../../../utils/default_constructors.h"
+#include "../../states/forward_states.h"
+#include "interval_diagram.h"
+
+#include <memory>
+#include <unordered_set>
+
+class Expression;
+class Model;
+
+namespace StartGenerator {
+
+    /**
+     * @brief Decision diagram representation of the start and unsafety condition over the bounded model variables.
+     *
+     * Kept in sync with the expression conditions by the strengthening strategy: every refinement removes the excluded
+     * states (or box) from the start set and adds them to the unsafety set.
+     * In contrast to the expressions, the diagrams answer emptiness and size of the start region exactly, and allow
+     * uniform sampling of start states.
+     */
+    class ConditionDiagrams {
+    public:
+        /// default bound on the number of valuations enumerated to build the initial diagrams.
+        static constexpr uint64_t default_max_domain_size = 1ULL << 26;
+
+        ConditionDiagrams(const Model& model, const Expression& start_condition, const Expression& unsafety_condition);
+        ~ConditionDiagrams();
+        DELETE_CONSTRUCTOR(ConditionDiagrams)
+
+        /// @return diagrams of both conditions, or nullptr if the domain of the model exceeds max_domain_size.
+        static std::unique_ptr<ConditionDiagrams> create(
+            const Model& model,
+            const Expression& start_condition,
+            const Expression& unsafety_condition,
+            uint64_t max_domain_size = default_max_domain_size);
+
+        /* Refinement */
+        void add_unsafe_state(const StateBase& state);
+        void add_unsafe_states(const std::unordered_set<std::unique_ptr<StateBase>>& states);
+
+        /// @brief Adds a box, given by its min and max corner over the model variables (excluding the location).
+        void add_unsafe_box(const std::vector<int>& min_corner, const std::vector<int>& max_corner);
+
+        /**
+         * @brief Adds an arbitrary overapproximation of the given states, e.g., a polyhedron.
+         *
+         * The region is enumerated within the bounding box of the states, which must contain it.
+         */
+        void add_unsafe_region(const Expression& region, const std::unordered_set<std::unique_ptr<StateBase>>& states);
+
+        /* Queries */
+        [[nodiscard]] bool is_start_empty() const { return start == IntervalDiagram::empty; }
+        [[nodiscard]] uint64_t start_size() { return diagram.count(start); }
+        [[nodiscard]] double start_fraction() { return diagram.fraction(start); }
+        [[nodiscard]] uint64_t unsafety_size() { return diagram.count(unsafety); }
+        [[nodiscard]] std::size_t num_nodes() const { return diagram.num_nodes(); }
+
+        /// @return start state drawn uniformly from the start region, nullptr if the region is empty.
+        [[nodiscard]] std::unique_ptr<StateBase> sample_start(RngStream& rng);
+
+        /* Export */
+        [[nodiscard]] std::unique_ptr<Expression> start_to_expression() const { return to_expression(start); }
+        [[nodiscard]] std::unique_ptr<Expression> unsafety_to_expression() const { return to_expression(unsafety); }
+
+    private:
+        const Model& model;
+        IntervalDiagram diagram;
+        IntervalDiagram::Node start;
+        IntervalDiagram::Node unsafety;
+
+        /// @return values of the model variables, i.e., without the location variable.
+        [[nodiscard]] static std::vector<int> to_values(const StateBase& state);
+
+        /// @return disjunction of the cubes of the node, each a conjunction of the non-trivial variable bounds.
+        [[nodiscard]] std::unique_ptr<Expression> to_expression(IntervalDiagram::Node node) const;
+    };
+
+} // namespace StartGenerator
+
+#endif //CONDITION_DIAGRAMS_H
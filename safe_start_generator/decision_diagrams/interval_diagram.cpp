@@ -0,0 +1,329 @@
+//
+// Created by Daniel Sherbakov in 2025.
+//
+
+#include "interval_diagram.h"
+
+#include "../testing/rng_stream.h"
+
+#include <algorithm>
+#include <cassert>
+#include <limits>
+
+namespace {
+    constexpr uint64_t saturated = std::numeric_limits<uint64_t>::max();
+    constexpr std::size_t max_apply_cache_size = 1 << 22;
+
+    uint64_t saturating_add(const uint64_t a, const uint64_t b) { return a > saturated - b ? saturated : a + b; }
+
+    uint64_t saturating_mul(const uint64_t a, const uint64_t b) {
+        if (a == 0 or b == 0) { return 0; }
+        return a > saturated / b ? saturated : a * b;
+    }
+}
+
+namespace StartGenerator {
+
+    IntervalDiagram::IntervalDiagram(std::vector<int> lower_bounds, std::vector<int> upper_bounds):
+        lower_bounds(std::move(lower_bounds)),
+        upper_bounds(std::move(upper_bounds)),
+        unique_table(0, NodeHash { this }, NodeEqual { this }) {
+        assert(this->lower_bounds.size() == this->upper_bounds.size());
+        const auto terminal_level = static_cast<uint32_t>(num_variables());
+        nodes.push_back({ terminal_level, 0, 0 }); // empty
+        nodes.push_back({ terminal_level, 0, 0 }); // full
+        counts = { 0, 1 };
+        fractions = { 0, 1 };
+    }
+
+    std::size_t IntervalDiagram::NodeHash::operator()(const Node node) const {
+        const auto& data = diagram->nodes[node];
+        std::size_t seed = data.level;
+        for (auto i = data.first_edge; i < data.first_edge + data.num_edges; ++i) {
+            const auto& edge = diagram->edges[i];
+            for (const auto value: { static_cast<uint32_t>(edge.lower), edge.child }) {
+                seed ^= value + 0x9E3779B97F4A7C15ULL + (seed << 6) + (seed >> 2);
+            }
+        }
+        return seed;
+    }
+
+    std::size_t IntervalDiagram::ApplyKeyHash::operator()(const ApplyKey& key) const {
+        // SplitMix64 finalization of both node ids, salted with the operation.
+        const auto salt = static_cast<uint64_t>(key.op) * 0x9E3779B97F4A7C15ULL;
+        uint64_t z = (static_cast<uint64_t>(key.a) << 32 | key.b) + salt;
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        return static_cast<std::size_t>(z ^ (z >> 31));
+    }
+
+    bool IntervalDiagram::NodeEqual::operator()(const Node a, const Node b) const {
+        const auto& data_a = diagram->nodes[a];
+        const auto& data_b = diagram->nodes[b];
+        if (data_a.level != data_b.level or data_a.num_edges != data_b.num_edges) { return false; }
+        for (uint32_t i = 0; i < data_a.num_edges; ++i) {
+            const auto& edge_a = diagram->edges[data_a.first_edge + i];
+            const auto& edge_b = diagram->edges[data_b.first_edge + i];
+            if (edge_a.lower != edge_b.lower or edge_a.upper != edge_b.upper or edge_a.child != edge_b.child) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    uint64_t IntervalDiagram::domain_size(const std::size_t var) const {
+        return static_cast<uint64_t>(static_cast<int64_t>(upper_bounds[var]) - lower_bounds[var] + 1);
+    }
+
+    void IntervalDiagram::get_edges(const Node node, const uint32_t var, std::vector<Edge>& out) const {
+        out.clear();
+        const auto& data = nodes[node];
+        if (data.level > var) {
+            out.push_back({ lower_bounds[var], upper_bounds[var], node });
+            return;
+        }
+        out.insert(out.end(), edges.begin() + data.first_edge, edges.begin() + data.first_edge + data.num_edges);
+    }
+
+    IntervalDiagram::Node IntervalDiagram::make_node(const uint32_t var, std::vector<Edge> node_edges) {
+        // merge adjacent intervals leading to the same child.
+        std::size_t merged = 0;
+        for (std::size_t i = 1; i < node_edges.size(); ++i) {
+            if (node_edges[i].child == node_edges[merged].child) {
+                node_edges[merged].upper = node_edges[i].upper;
+            } else {
+                node_edges[++merged] = node_edges[i];
+            }
+        }
+        node_edges.resize(merged + 1);
+        if (node_edges.size() == 1) { return node_edges.front().child; } // variable is irrelevant.
+
+        const auto candidate = static_cast<Node>(nodes.size());
+        nodes.push_back({ var, static_cast<uint32_t>(edges.size()), static_cast<uint32_t>(node_edges.size()) });
+        edges.insert(edges.end(), node_edges.begin(), node_edges.end());
+        const auto [it, inserted] = unique_table.insert(candidate);
+        if (not inserted) {
+            edges.resize(nodes.back().first_edge);
+            nodes.pop_back();
+            return *it;
+        }
+        counts.push_back(saturated);
+        fractions.push_back(-1);
+        return candidate;
+    }
+
+    IntervalDiagram::Node IntervalDiagram::point(const std::vector<int>& values) {
+        return cube({ values, values });
+    }
+
+    IntervalDiagram::Node IntervalDiagram::cube(const Cube& cube) {
+        Node node = full;
+        for (auto var = static_cast<uint32_t>(num_variables()); var-- > 0;) {
+            const int lower = std::max(cube.lower[var], lower_bounds[var]);
+            const int upper = std::min(cube.upper[var], upper_bounds[var]);
+            if (lower > upper) { return empty; }
+            std::vector<Edge> node_edges;
+            if (lower > lower_bounds[var]) { node_edges.push_back({ lower_bounds[var], lower - 1, empty }); }
+            node_edges.push_back({ lower, upper, node });
+            if (upper < upper_bounds[var]) { node_edges.push_back({ upper + 1, upper_bounds[var], empty }); }
+            node = make_node(var, std::move(node_edges));
+        }
+        return node;
+    }
+
+    IntervalDiagram::Node IntervalDiagram::from_predicate(const std::function<bool(const std::vector<int>&)>& predicate) {
+        return from_predicate(predicate, { lower_bounds, upper_bounds });
+    }
+
+    IntervalDiagram::Node IntervalDiagram::from_predicate(
+        const std::function<bool(const std::vector<int>&)>& predicate,
+        const Cube& cube) {
+        for (std::size_t var = 0; var < num_variables(); ++var) {
+            if (std::max(cube.lower[var], lower_bounds[var]) > std::min(cube.upper[var], upper_bounds[var])) {
+                return empty;
+            }
+        }
+        std::vector<int> values(lower_bounds);
+        return build(0, values, cube, predicate);
+    }
+
+    IntervalDiagram::Node IntervalDiagram::build(
+        const uint32_t var,
+        std::vector<int>& values,
+        const Cube& cube,
+        const std::function<bool(const std::vector<int>&)>& predicate) {
+        if (var == num_variables()) { return predicate(values) ? full : empty; }
+        const int lower = std::max(cube.lower[var], lower_bounds[var]);
+        const int upper = std::min(cube.upper[var], upper_bounds[var]);
+        std::vector<Edge> node_edges;
+        if (lower > lower_bounds[var]) { node_edges.push_back({ lower_bounds[var], lower - 1, empty }); }
+        for (int value = lower;; ++value) {
+            values[var] = value;
+            const Node child = build(var + 1, values, cube, predicate);
+            if (not node_edges.empty() and node_edges.back().child == child) {
+                node_edges.back().upper = value;
+            } else {
+                node_edges.push_back({ value, value, child });
+            }
+            if (value == upper) { break; }
+        }
+        if (upper < upper_bounds[var]) {
+            if (node_edges.back().child == empty) {
+                node_edges.back().upper = upper_bounds[var];
+            } else {
+                node_edges.push_back({ upper + 1, upper_bounds[var], empty });
+            }
+        }
+        return make_node(var, std::move(node_edges));
+    }
+
+    IntervalDiagram::Node IntervalDiagram::apply(const Op op, Node a, Node b) {
+        // terminal cases.
+        switch (op) {
+            case Op::Union: {
+                if (a == full or b == full) { return full; }
+                if (a == empty or a == b) { return b; }
+                if (b == empty) { return a; }
+                break;
+            }
+            case Op::Intersection: {
+                if (a == empty or b == empty) { return empty; }
+                if (a == full or a == b) { return b; }
+                if (b == full) { return a; }
+                break;
+            }
+            case Op::Difference: {
+                if (a == empty or b == full or a == b) { return empty; }
+                if (b == empty) { return a; }
+                break;
+            }
+        }
+
+        if (op != Op::Difference and a > b) { std::swap(a, b); } // commutative.
+        const ApplyKey key { op, a, b };
+        if (const auto it = apply_cache.find(key); it != apply_cache.end()) { return it->second; }
+
+        // simultaneous sweep over both interval partitions of the top variable.
+        const uint32_t var = std::min(level(a), level(b));
+        std::vector<Edge> edges_a;
+        std::vector<Edge> edges_b;
+        get_edges(a, var, edges_a);
+        get_edges(b, var, edges_b);
+
+        std::vector<Edge> result;
+        std::size_t i = 0;
+        std::size_t j = 0;
+        int64_t lower = lower_bounds[var];
+        while (lower <= upper_bounds[var]) {
+            const int upper = std::min(edges_a[i].upper, edges_b[j].upper);
+            result.push_back({ static_cast<int>(lower), upper, apply(op, edges_a[i].child, edges_b[j].child) });
+            if (edges_a[i].upper == upper) { ++i; }
+            if (edges_b[j].upper == upper) { ++j; }
+            lower = static_cast<int64_t>(upper) + 1;
+        }
+
+        const Node node = make_node(var, std::move(result));
+        if (apply_cache.size() >= max_apply_cache_size) { apply_cache.clear(); }
+        apply_cache.emplace(key, node);
+        return node;
+    }
+
+    bool IntervalDiagram::contains(Node root, const std::vector<int>& values) const {
+        while (root != empty and root != full) {
+            const auto& data = nodes[root];
+            const auto first = edges.begin() + data.first_edge;
+            const auto last = first + data.num_edges;
+            const int value = values[data.level];
+            const auto it = std::partition_point(first, last, [value](const Edge& edge) { return edge.upper < value; });
+            if (it == last or it->lower > value) { return false; } // out of domain.
+            root = it->child;
+        }
+        return root == full;
+    }
+
+    uint64_t IntervalDiagram::count(const Node root) { return count_from(0, root); }
+
+    uint64_t IntervalDiagram::count_from(const uint32_t from, const Node node) {
+        if (counts[node] == saturated and node != empty and node != full) {
+            const auto data = nodes[node];
+            uint64_t node_count = 0;
+            for (auto i = data.first_edge; i < data.first_edge + data.num_edges; ++i) {
+                const auto edge = edges[i];
+                const auto width = static_cast<uint64_t>(static_cast<int64_t>(edge.upper) - edge.lower + 1);
+                node_count = saturating_add(node_count, saturating_mul(width, count_from(data.level + 1, edge.child)));
+            }
+            counts[node] = node_count;
+        }
+        uint64_t result = counts[node];
+        for (auto var = from; var < level(node); ++var) { result = saturating_mul(result, domain_size(var)); }
+        return result;
+    }
+
+    double IntervalDiagram::fraction(const Node root) { return fraction_of(root); }
+
+    double IntervalDiagram::fraction_of(const Node node) {
+        if (fractions[node] < 0) {
+            const auto data = nodes[node];
+            const auto dom = static_cast<double>(domain_size(data.level));
+            double node_fraction = 0;
+            for (auto i = data.first_edge; i < data.first_edge + data.num_edges; ++i) {
+                const auto edge = edges[i];
+                const double width = static_cast<double>(edge.upper) - edge.lower + 1;
+                node_fraction += width / dom * fraction_of(edge.child);
+            }
+            fractions[node] = node_fraction;
+        }
+        return fractions[node];
+    }
+
+    std::vector<int> IntervalDiagram::sample(Node root, RngStream& rng) {
+        assert(root != empty);
+        std::vector<int> values(num_variables());
+        for (uint32_t var = 0; var < num_variables(); ++var) {
+            if (level(root) > var) { // irrelevant variable.
+                values[var] = lower_bounds[var] + static_cast<int>(rng.index(domain_size(var)));
+                continue;
+            }
+            // choose an interval proportional to the number of valuations below it.
+            const auto data = nodes[root];
+            const auto dom = static_cast<double>(domain_size(var));
+            double threshold = rng.prob() * fraction_of(root);
+            Edge chosen = edges[data.first_edge];
+            for (auto i = data.first_edge; i < data.first_edge + data.num_edges; ++i) {
+                const auto& edge = edges[i];
+                if (edge.child == empty) { continue; }
+                chosen = edge;
+                threshold -= (static_cast<double>(edge.upper) - edge.lower + 1) / dom * fraction_of(edge.child);
+                if (threshold < 0) { break; }
+            }
+            const auto width = static_cast<std::size_t>(static_cast<int64_t>(chosen.upper) - chosen.lower + 1);
+            values[var] = chosen.lower + static_cast<int>(rng.index(width));
+            root = chosen.child;
+        }
+        return values;
+    }
+
+    std::vector<IntervalDiagram::Cube> IntervalDiagram::to_cubes(const Node root) const {
+        std::vector<Cube> cubes;
+        Cube current { lower_bounds, upper_bounds };
+        const std::function<void(Node)> visit = [&](const Node node) {
+            if (node == empty) { return; }
+            if (node == full) {
+                cubes.push_back(current);
+                return;
+            }
+            const auto& data = nodes[node];
+            for (auto i = data.first_edge; i < data.first_edge + data.num_edges; ++i) {
+                const auto& edge = edges[i];
+                current.lower[data.level] = edge.lower;
+                current.upper[data.level] = edge.upper;
+                visit(edge.child);
+            }
+            current.lower[data.level] = lower_bounds[data.level];
+            current.upper[data.level] = upper_bounds[data.level];
+        };
+        visit(root);
+        return cubes;
+    }
+
+} // namespace StartGenerator
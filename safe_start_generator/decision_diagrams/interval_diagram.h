@@ -0,0 +1,154 @@
+//
+// Created by Daniel Sherbakov in 2025.
+//
+
+#ifndef INTERVAL_DIAGRAM_H
+#define INTERVAL_DIAGRAM_H
+
+#include "../../../utils/default_constructors.h"
+
+#include <cstdint>
+#include <functional>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+namespace StartGenerator {
+
+    class RngStream;
+
+    /**
+     * @brief Reduced, ordered multi-valued decision diagrams over bounded integer variables.
+     *
+     * Variable i of the manager is decided at level i and ranges over [lower_bounds[i], upper_bounds[i]].
+     * Each inner node partitions the domain of its variable into maximal intervals, where adjacent intervals lead to
+     * different children. Nodes are hash-consed, hence equal sets are represented by the same node and emptiness is a
+     * constant time check. Levels may be skipped, i.e., a child deciding a later level does not depend on the values in
+     * between.
+     *
+     * Nodes are never freed; the manager is meant to live as long as the conditions it represents.
+     */
+    class IntervalDiagram {
+    public:
+        using Node = uint32_t;
+        static constexpr Node empty = 0;
+        static constexpr Node full = 1;
+
+        struct Edge {
+            int lower;
+            int upper;
+            Node child;
+        };
+
+        /// per variable inclusive bounds, e.g., the bounds of a box.
+        struct Cube {
+            std::vector<int> lower;
+            std::vector<int> upper;
+        };
+
+        IntervalDiagram(std::vector<int> lower_bounds, std::vector<int> upper_bounds);
+        ~IntervalDiagram() = default;
+        DELETE_CONSTRUCTOR(IntervalDiagram) // the unique table refers to this instance.
+
+        [[nodiscard]] std::size_t num_variables() const { return lower_bounds.size(); }
+        [[nodiscard]] std::size_t num_nodes() const { return nodes.size(); }
+
+        /* Construction */
+        [[nodiscard]] Node point(const std::vector<int>& values);
+        [[nodiscard]] Node cube(const Cube& cube);
+
+        /**
+         * @brief Builds the diagram of a predicate by enumerating the domain in lexicographic order.
+         *
+         * Subdiagrams are reduced bottom-up while enumerating, so memory stays linear in the number of variables plus
+         * the size of the result. Time is linear in the size of the domain.
+         */
+        [[nodiscard]] Node from_predicate(const std::function<bool(const std::vector<int>&)>& predicate);
+
+        /// as above, restricted to the valuations inside of cube.
+        [[nodiscard]] Node from_predicate(const std::function<bool(const std::vector<int>&)>& predicate, const Cube& cube);
+
+        /* Set operations */
+        [[nodiscard]] Node unite(Node a, Node b) { return apply(Op::Union, a, b); }
+        [[nodiscard]] Node intersect(Node a, Node b) { return apply(Op::Intersection, a, b); }
+        [[nodiscard]] Node subtract(Node a, Node b) { return apply(Op::Difference, a, b); }
+
+        /* Queries */
+        [[nodiscard]] bool contains(Node root, const std::vector<int>& values) const;
+
+        /// @return exact number of valuations in the set, saturated at UINT64_MAX.
+        [[nodiscard]] uint64_t count(Node root);
+
+        /// @return size of the set relative to the size of the whole domain.
+        [[nodiscard]] double fraction(Node root);
+
+        /// @return valuation drawn uniformly from the (non-empty) set.
+        [[nodiscard]] std::vector<int> sample(Node root, RngStream& rng);
+
+        /// @return disjoint cubes covering the set, one per path to the full terminal.
+        [[nodiscard]] std::vector<Cube> to_cubes(Node root) const;
+
+    private:
+        enum class Op : uint8_t { Union, Intersection, Difference };
+
+        struct NodeData {
+            uint32_t level;
+            uint32_t first_edge;
+            uint32_t num_edges;
+        };
+
+        std::vector<int> lower_bounds;
+        std::vector<int> upper_bounds;
+
+        std::vector<NodeData> nodes;
+        std::vector<Edge> edges;
+
+        struct NodeHash {
+            const IntervalDiagram* diagram;
+            std::size_t operator()(Node node) const;
+        };
+        struct NodeEqual {
+            const IntervalDiagram* diagram;
+            bool operator()(Node a, Node b) const;
+        };
+        std::unordered_set<Node, NodeHash, NodeEqual> unique_table;
+        struct ApplyKey {
+            Op op;
+            Node a;
+            Node b;
+            bool operator==(const ApplyKey& other) const { return op == other.op and a == other.a and b == other.b; }
+        };
+        struct ApplyKeyHash {
+            std::size_t operator()(const ApplyKey& key) const;
+        };
+        std::unordered_map<ApplyKey, Node, ApplyKeyHash> apply_cache;
+
+        // per node caches, valid forever as nodes are immutable.
+        std::vector<uint64_t> counts;
+        std::vector<double> fractions;
+
+        [[nodiscard]] uint32_t level(const Node node) const { return nodes[node].level; }
+        [[nodiscard]] uint64_t domain_size(std::size_t var) const;
+
+        /// @return edges of node at the given level; a node deciding a later level yields a single full-domain edge.
+        void get_edges(Node node, uint32_t var, std::vector<Edge>& out) const;
+
+        /// merges adjacent edges with equal children and returns the unique node.
+        Node make_node(uint32_t var, std::vector<Edge> node_edges);
+
+        Node apply(Op op, Node a, Node b);
+        Node build(
+            uint32_t var,
+            std::vector<int>& values,
+            const Cube& cube,
+            const std::function<bool(const std::vector<int>&)>& predicate);
+
+        /// @return count of node over the levels [level(node), n), scaled by the skipped levels [from, level(node)).
+        uint64_t count_from(uint32_t from, Node node);
+        double fraction_of(Node node);
+    };
+
+} // namespace StartGenerator
+
+#endif //INTERVAL_DIAGRAM_H
@@ -7,6 +7,7 @@
 #include "../../parser/visitor/to_normalform.h"
 #include "../../stats/stats_base.h"
 #include "../../stats/stats_unsigned.h"
+#include "../../utils/rng.h"
 #include "../factories/configuration.h"
 #include "../factories/safe_start_generator/safe_start_generator_options.h"
 #include "../fd_adaptions/timer.h"
@@ -14,15 +15,27 @@
 #include "../predicate_abstraction/smt/model_z3_pa.h"
 #include "approximation_methods/bounding_box.h"
 #include "start_generation_statistics.h"
+#include "start_generator_options.h"
+#include "state_valuation.h"
+#include "strengthening_strategy/condition_metrics.h"
 #include "verification_methods/invariant_strengthening.h"
 #include "verification_methods/verification_method_factory.h"
 
+#include <sstream>
+#include <stdexcept>
+#include <string>
+
 SafeStartGenerator::SafeStartGenerator(const PLAJA::Configuration& config):
     SearchEngine(config),
     config(config),
     verification_type(
         VerificationMethods::string_to_type(config.get_value_option_string(PLAJA_OPTION::verification_method))),
-    alternating_mode(config.is_flag_set(PLAJA_OPTION::alternate)) {
+    alternating_mode(config.is_flag_set(PLAJA_OPTION::alternate)),
+    // unbounded without a time limit.
+    engine_deadline(
+        config.has_int_option(PLAJA_OPTION::max_time)
+            ? config.get_int_option(PLAJA_OPTION::max_time) * (1 - deadline_reserve)
+            : 0) {
     // init statistics.
     StartGenerationStatistics::add_basic_stats(*searchStatistics);
     if (config.has_value_option(PLAJA_OPTION::iteration_stats)) {
@@ -30,22 +43,23 @@ SafeStartGenerator::SafeStartGenerator(const PLAJA::Configuration& config):
             std::make_unique<StartGenerationStatistics>(config.get_value_option_string(PLAJA_OPTION::iteration_stats));
     }
 
-    // init general safety property.
-    unsafety_condition = propertyInfo->get_reach()->deepCopy_Exp();
-    if (verification_type == VerificationMethods::Type::INVARIANT_STRENGTHENING) {
-        PLAJA_LOG("Start is set to negation of unsafety.")
-        start_condition = unsafety_condition->deepCopy_Exp();
-        TO_NORMALFORM::negate(start_condition);
-        TO_NORMALFORM::normalize(start_condition);
-        TO_NORMALFORM::specialize(start_condition);
+    // properties to generate start conditions for; in batch mode, all components not specific to a property are shared.
+    if (config.has_value_option(PLAJA_OPTION::properties)) {
+        for (const auto index: parse_property_indices(config.get_value_option_string(PLAJA_OPTION::properties))) {
+            property_indices.push_back(index);
+            batch_properties.push_back(PropertyInformation::analyse_property(*model->get_property(index), *model));
+        }
     } else {
-        start_condition = propertyInfo->get_start()->deepCopy_Exp();
+        property_indices.push_back(1);
     }
 
     sim_env = std::make_unique<SimulationEnvironment>(config, *model);
-    // create once, update later.
-    enumerator = std::make_unique<InitialStatesEnumerator>(config, *start_condition);
-    const Approximation::Type approximation_type =
+    successor_cache = std::make_unique<StartGenerator::SuccessorCache>(*sim_env);
+    // randomness is derived from the global (seeded) rng once, then drawn from streams keyed by their use.
+    // start states the enumerator draws still come from the global rng, but only on this thread and in start order.
+    rng_streams = std::make_unique<StartGenerator::RngStreamFactory>(
+        (static_cast<uint64_t>(PLAJA_GLOBAL::rng->index(UINT32_MAX)) << 32) | PLAJA_GLOBAL::rng->index(UINT32_MAX));
+    approximation_type =
         config.has_value_option(PLAJA_OPTION::approximation_type)
             ? Approximation::string_to_type(config.get_value_option_string(PLAJA_OPTION::approximation_type))
             : Approximation::Type::None;
@@ -54,18 +68,111 @@ SafeStartGenerator::SafeStartGenerator(const PLAJA::Configuration& config):
         approximate_testing = true;
         approximate_verification = approximate == "both";
     }
-    strengthening_strategy =
-        StrengtheningStrategy::create(verification_type, *model, approximation_type, per_iteration_stats.get());
-
-    iteration_mode = Mode::Verification;
+    // the bounding box of the unsafe states of a testing phase is built while they are collected.
+    if (approximate_testing and approximation_type == Approximation::Type::Overapproximation) {
+        unsafe_box = std::make_unique<StartGenerator::BoxAccumulator>(*model);
+    }
 
     // init testing.
     if ((use_testing = config.is_flag_set(PLAJA_OPTION::use_testing))) {
-        iteration_mode = Mode::Testing;
         terminate_cycles = config.is_flag_set(PLAJA_OPTION::terminate_on_cycles);
         use_policy_run_sampling = config.is_flag_set(PLAJA_OPTION::policy_run_sampling);
         testing_time_limit = config.get_int_option(PLAJA_OPTION::testing_time);
+        if (config.has_value_option(PLAJA_OPTION::testing_mode)) {
+            testing_mode = Testing::string_to_mode(config.get_value_option_string(PLAJA_OPTION::testing_mode));
+        }
+        if (config.has_value_option(PLAJA_OPTION::trajectory_log)) {
+            trajectory_log = std::make_unique<StartGenerator::TrajectoryLog>(
+                config.get_value_option_string(PLAJA_OPTION::trajectory_log),
+                model->get_model_information().get_initial_values().get_int_state_size());
+        }
     }
+
+    validation_rollouts = PLAJA_OPTION::START_GENERATOR::get_int_option(config, PLAJA_OPTION::validation_rollouts);
+    const auto threads = PLAJA_OPTION::START_GENERATOR::get_int_option(config, PLAJA_OPTION::num_threads);
+    if (threads <= 0) { throw std::invalid_argument("Number of threads must be positive: " + std::to_string(threads)); }
+    num_threads = static_cast<unsigned>(threads);
+    // the properties of a batch are checked against the same policy.
+    if (use_testing or validation_rollouts > 0) {
+        policy_cache =
+            std::make_unique<StartGenerator::PolicyCache>(propertyInfo->get_nn_interface()->load_policy(config));
+    }
+
+    // created once, so that encodings (e.g., of the policy) are shared by all iterations and properties.
+    verification_method = get_verification_method();
+    init_property();
+}
+
+const PropertyInformation& SafeStartGenerator::get_property_info() const {
+    return is_batch() ? *batch_properties[current_property] : *propertyInfo;
+}
+
+/// sets up the conditions and all components specific to the current property.
+void SafeStartGenerator::init_property() {
+    const auto& property_info = get_property_info();
+    if (is_batch()) {
+        const auto property_index = property_indices[current_property];
+        PLAJA_LOG("Generating start condition for property " + std::to_string(property_index) + " ...")
+        verification_method->set_property(property_index);
+        if (per_iteration_stats) { per_iteration_stats->set_property(property_index); }
+    }
+    // the remaining time is split evenly among the remaining properties.
+    const auto num_remaining = property_indices.size() - current_property;
+    deadline = engine_deadline.is_bounded() ? engine_deadline.limit(engine_deadline.remaining() / num_remaining)
+                                            : engine_deadline;
+
+    // init general safety property.
+    using Junction = StartGenerator::JunctionCondition::Junction;
+    unsafety_condition = std::make_unique<StartGenerator::JunctionCondition>(
+        property_info.get_reach()->deepCopy_Exp(),
+        Junction::Disjunction);
+    // the portfolio needs conditions on which an empty result of any member proves safety, i.e., an invariant.
+    if (verification_type == VerificationMethods::Type::INVARIANT_STRENGTHENING or
+        verification_type == VerificationMethods::Type::PORTFOLIO) {
+        PLAJA_LOG("Start is set to negation of unsafety.")
+        auto negated_unsafety = property_info.get_reach()->deepCopy_Exp();
+        TO_NORMALFORM::negate(negated_unsafety);
+        start_condition = std::make_unique<StartGenerator::JunctionCondition>(
+            std::move(negated_unsafety),
+            Junction::Conjunction);
+    } else {
+        start_condition = std::make_unique<StartGenerator::JunctionCondition>(
+            property_info.get_start()->deepCopy_Exp(),
+            Junction::Conjunction);
+    }
+
+    envelope = std::make_unique<StartGenerator::PolicyEnvelope>(); // unsafety labels depend on the property.
+    // create once, update later.
+    enumerator = std::make_unique<InitialStatesEnumerator>(config, start_condition->get());
+    start_sampler = std::make_unique<StartGenerator::StartSampler>(
+        *enumerator,
+        *model,
+        start_condition->get(),
+        PLAJA_OPTION::START_GENERATOR::get_double_option(config, PLAJA_OPTION::seed_fraction),
+        PLAJA_OPTION::START_GENERATOR::get_double_option(config, PLAJA_OPTION::seed_radius),
+        rng_streams->derive(START_SAMPLING_STREAMS).stream(current_property));
+    // tested start states are specific to the unsafety condition, hence the filter is kept across iterations only.
+    const auto max_start_resamples =
+        PLAJA_OPTION::START_GENERATOR::get_int_option(config, PLAJA_OPTION::max_start_resamples);
+    start_coverage = max_start_resamples > 0 ? std::make_unique<StartGenerator::StartCoverage>() : nullptr;
+    start_sampler->set_coverage(start_coverage.get(), max_start_resamples);
+    strengthening_strategy =
+        StrengtheningStrategy::create(verification_type, *model, approximation_type, per_iteration_stats.get());
+    if (approximation_type == Approximation::Type::MultiUnderapproximation) {
+        strengthening_strategy->set_multi_box_limits(
+            PLAJA_OPTION::START_GENERATOR::get_int_option(config, PLAJA_OPTION::max_boxes),
+            PLAJA_OPTION::START_GENERATOR::get_int_option(config, PLAJA_OPTION::box_coverage) / 100.0);
+    }
+    condition_diagrams = nullptr;
+    emptiness_check = nullptr;
+    if (config.is_flag_set(PLAJA_OPTION::use_decision_diagrams)) {
+        condition_diagrams =
+            StartGenerator::ConditionDiagrams::create(*model, start_condition->get(), unsafety_condition->get());
+        strengthening_strategy->set_condition_diagrams(condition_diagrams.get());
+    }
+    if (not condition_diagrams) { emptiness_check = std::make_unique<StartGenerator::StartEmptinessCheck>(config); }
+
+    iteration_mode = use_testing ? Mode::Testing : Mode::Verification;
 }
 
 SafeStartGenerator::~SafeStartGenerator() = default;
@@ -75,18 +182,57 @@ SearchEngine::SearchStatus SafeStartGenerator::initialize() { return SearchStatu
 SearchEngine::SearchStatus SafeStartGenerator::finalize() { return SearchStatus::IN_PROGRESS; }
 
 SearchEngine::SearchStatus SafeStartGenerator::step() {
+    const auto status = step_property();
+    if (status == SearchStatus::IN_PROGRESS or not is_batch()) { return status; }
+
+    property_results.push_back(status);
+    if (++current_property < property_indices.size()) {
+        init_property();
+        return SearchStatus::IN_PROGRESS;
+    }
+    return finish_batch();
+}
+
+/// @return SOLVED if all properties were solved, TIMEOUT if any timed out, and FINISHED otherwise.
+SearchEngine::SearchStatus SafeStartGenerator::finish_batch() const {
+    bool all_solved = true;
+    bool any_timeout = false;
+    std::cout << "Batch results:" << '\n';
+    for (std::size_t i = 0; i < property_indices.size(); ++i) {
+        const auto status = property_results[i];
+        all_solved = all_solved and status == SOLVED;
+        any_timeout = any_timeout or status == TIMEOUT;
+        std::cout << "  property " << property_indices[i] << ": "
+                  << (status == SOLVED ? "safe start" : status == TIMEOUT ? "unverified" : "empty") << '\n';
+    }
+    if (all_solved) { return SOLVED; }
+    return any_timeout ? TIMEOUT : FINISHED;
+}
+
+SearchEngine::SearchStatus SafeStartGenerator::step_property() {
+    // results of completed phases are reported even at the deadline.
+    const bool phase_pending = iteration_mode == Mode::Testing or iteration_mode == Mode::Verification;
+    if (phase_pending and deadline.is_expired()) { return report_timeout(); }
 
     switch (iteration_mode) {
         case Mode::Testing: iteration_mode = run_testing(); break;
         case Mode::Verification: iteration_mode = run_verification(); break;
         case Mode::CheckStart: return check_start_condition();
+        case Mode::StartEmpty: return report_start_condition(false);
     }
 
     searchStatistics->inc_attr_unsigned(PLAJA::StatsUnsigned::ITERATIONS);
+    if (condition_diagrams and per_iteration_stats) {
+        per_iteration_stats->set_start_region_size(condition_diagrams->start_fraction());
+    }
     dump_iteration_stats();
+    if (iteration_mode == Mode::StartEmpty) {
+        PLAJA_LOG("Start condition became empty during refinement.")
+        return report_start_condition(false);
+    }
 
     // update strengthening method.
-    enumerator->update_start_condition(*start_condition);
+    enumerator->update_start_condition(start_condition->get());
 
     return SearchStatus::IN_PROGRESS;
 }
@@ -96,28 +242,66 @@ SafeStartGenerator::Mode SafeStartGenerator::run_testing() {
     per_iteration_stats->testing_iteration();
     PUSH_LAP(searchStatistics, PLAJA::StatsDouble::TOTAL_TESTING_TIME);
     PUSH_LAP_IF(per_iteration_stats.get(), PLAJA::StatsDouble::SEARCHING_TIME);
-    const auto unsafe_states_ids = get_unsafe_path_identifier()->identify_unsafe_paths();
+    std::unordered_set<std::unique_ptr<StateBase>> unsafe_states;
+    if (unsafe_box) { unsafe_box->clear(); }
+    if (testing_mode == Testing::Mode::Exhaustive) {
+        const auto explorer = get_envelope_explorer();
+        unsafe_states = explorer->explore();
+        if (per_iteration_stats) { per_iteration_stats->set_exploration_complete(explorer->is_complete()); }
+    } else {
+        successor_cache->reset_counters();
+        policy_cache->reset_counters();
+        start_sampler->reset_counters();
+        const bool use_safe_samples = approximation_type == Approximation::Type::DecisionTree;
+        if (testing_mode == Testing::Mode::Splitting) {
+            const auto splitting = get_splitting_search();
+            unsafe_states = get_unsafe_states(splitting->identify_unsafe_paths());
+            if (use_safe_samples) {
+                strengthening_strategy->set_safe_samples(get_valuations(splitting->get_safe_state_ids()));
+            }
+        } else {
+            const auto identifier = get_unsafe_path_identifier();
+            unsafe_states = get_unsafe_states(identifier->identify_unsafe_paths());
+            if (use_safe_samples) {
+                strengthening_strategy->set_safe_samples(get_valuations(identifier->get_safe_state_ids()));
+            }
+        }
+        if (per_iteration_stats) {
+            per_iteration_stats->set_successor_cache_hit_rate(successor_cache->hit_rate());
+            per_iteration_stats->set_policy_cache_hit_rate(policy_cache->hit_rate());
+            per_iteration_stats->set_seeded_starts(start_sampler->get_num_seeded());
+            if (start_coverage) {
+                per_iteration_stats->set_start_coverage(
+                    start_sampler->get_num_samples(),
+                    start_sampler->get_num_distinct(),
+                    start_coverage->fill_ratio());
+            }
+        }
+    }
     POP_LAP(searchStatistics, PLAJA::StatsDouble::TOTAL_TESTING_TIME);
     POP_LAP_IF(per_iteration_stats.get(), PLAJA::StatsDouble::SEARCHING_TIME);
-    std::cout << unsafe_states_ids.size() << " unsafe states found" << '\n';
+    std::cout << unsafe_states.size() << " unsafe states found" << '\n';
     Mode next_mode;
-    if (!unsafe_states_ids.empty()) {
-        searchStatistics->inc_attr_unsigned(PLAJA::StatsUnsigned::UNSAFE_STATES, unsafe_states_ids.size());
+    if (!unsafe_states.empty()) {
+        searchStatistics->inc_attr_unsigned(PLAJA::StatsUnsigned::UNSAFE_STATES, unsafe_states.size());
         if (per_iteration_stats) {
-            per_iteration_stats->inc_unsigned(PLAJA::StatsUnsigned::UNSAFE_STATES, unsafe_states_ids.size());
+            per_iteration_stats->inc_unsigned(PLAJA::StatsUnsigned::UNSAFE_STATES, unsafe_states.size());
+            per_iteration_stats->set_unsafe_states(unsafe_states);
         }
-        auto unsafe_states = get_unsafe_states(unsafe_states_ids);
+        start_sampler->add_counterexamples(unsafe_states);
         PUSH_LAP_IF(per_iteration_stats.get(),PLAJA::StatsDouble::REFINING_TIME)
         PUSH_LAP(searchStatistics, PLAJA::StatsDouble::TOTAL_REFINING_TIME);
-        auto [new_start, new_unsafety] = strengthening_strategy->update_conditions(
+        // exhaustive exploration returns its states directly, their bounds are not accumulated.
+        strengthening_strategy->update_conditions(
             *start_condition,
             *unsafety_condition,
             approximate_testing,
-            unsafe_states);
+            unsafe_states,
+            testing_mode == Testing::Mode::Exhaustive ? nullptr : unsafe_box.get());
+        const bool empty = is_start_empty();
         POP_LAP_IF(per_iteration_stats.get(),PLAJA::StatsDouble::REFINING_TIME)
         POP_LAP(searchStatistics, PLAJA::StatsDouble::TOTAL_REFINING_TIME);
-        start_condition = std::move(new_start);
-        unsafety_condition = std::move(new_unsafety);
+        if (empty) { return Mode::StartEmpty; }
         next_mode = alternating_mode ? Mode::Verification : Mode::Testing;
     } else {
         // increase_testing_time_limit();
@@ -129,20 +313,25 @@ SafeStartGenerator::Mode SafeStartGenerator::run_testing() {
 SafeStartGenerator::Mode SafeStartGenerator::run_verification() {
     PLAJA_LOG("Running verification... ")
     if (per_iteration_stats) { per_iteration_stats->verification_iteration(); }
-    const auto verification_method = get_verification_method();
-    auto unsafe_states = verification_method->run(*start_condition, *unsafety_condition);
-    if (unsafe_states.empty()) { return Mode::CheckStart; }
+    auto unsafe_states = verification_method->run(start_condition->get(), unsafety_condition->get(), deadline);
+    if (unsafe_states.empty()) {
+        // an interrupted run does not prove safety.
+        return deadline.is_expired() ? Mode::Verification : Mode::CheckStart;
+    }
+    if (per_iteration_stats) { per_iteration_stats->set_unsafe_states(unsafe_states); }
+    start_sampler->add_counterexamples(unsafe_states);
     PUSH_LAP_IF(per_iteration_stats.get(),PLAJA::StatsDouble::REFINING_TIME)
     PUSH_LAP(searchStatistics, PLAJA::StatsDouble::TOTAL_REFINING_TIME);
-    auto [new_start, new_unsafety] = strengthening_strategy->update_conditions(
+    strengthening_strategy->update_conditions(
         *start_condition,
         *unsafety_condition,
         approximate_verification,
-        unsafe_states);
+        unsafe_states,
+        nullptr);
+    const bool empty = is_start_empty();
     POP_LAP_IF(per_iteration_stats.get(),PLAJA::StatsDouble::REFINING_TIME)
     POP_LAP(searchStatistics, PLAJA::StatsDouble::TOTAL_REFINING_TIME);
-    start_condition = std::move(new_start);
-    unsafety_condition = std::move(new_unsafety);
+    if (empty) { return Mode::StartEmpty; }
     const auto next_mode = (use_testing || alternating_mode) ? Mode::Testing : Mode::Verification;
     return next_mode;
 }
@@ -150,9 +339,22 @@ SafeStartGenerator::Mode SafeStartGenerator::run_verification() {
 /// @returns SOLVED if start condition is not empty, and FINISHED otherwise
 SearchEngine::SearchStatus SafeStartGenerator::check_start_condition() {
     PLAJA_LOG("Checking start condition...")
-    auto start_state = enumerator->sample_state();
-    auto found = start_state != nullptr;
+    bool found;
+    if (condition_diagrams) {
+        // exact emptiness check.
+        found = not condition_diagrams->is_start_empty();
+        std::cout << condition_diagrams->start_size() << " start states remain." << '\n';
+        if (found) { condition_diagrams->start_to_expression()->dump(true); }
+    } else {
+        found = enumerator->sample_state() != nullptr;
+    }
+    return report_start_condition(found);
+}
+
+/// @returns SOLVED if start condition is not empty, and FINISHED otherwise
+SearchEngine::SearchStatus SafeStartGenerator::report_start_condition(const bool found) {
     if (per_iteration_stats) {per_iteration_stats->set_start_condition_status(found);}
+    if (found and validation_rollouts > 0) { validate_start_condition(); }
     dump_iteration_stats();
     if (found) {
         PLAJA_LOG("Start condition is safe.")
@@ -163,21 +365,101 @@ SearchEngine::SearchStatus SafeStartGenerator::check_start_condition() {
 }
 
 
+SearchEngine::SearchStatus SafeStartGenerator::report_timeout() {
+    PLAJA_LOG("Time limit reached, current start condition (unverified):")
+    start_condition->get().dump(true);
+    if (per_iteration_stats) { per_iteration_stats->set_start_condition_unverified(); }
+    dump_iteration_stats();
+    return TIMEOUT;
+}
+
+bool SafeStartGenerator::is_start_empty() const {
+    if (condition_diagrams) { return condition_diagrams->is_start_empty(); }
+    return emptiness_check->is_empty(*start_condition, deadline);
+}
+
 std::unique_ptr<UnsafePathIdentifier> SafeStartGenerator::get_unsafe_path_identifier() {
     return std::make_unique<UnsafePathIdentifier>(
         config,
-        testing_time_limit,
+        deadline.limit(testing_time_limit),
         *sim_env,
-        propertyInfo->get_nn_interface()->load_policy(config),
-        *start_condition,
-        *unsafety_condition,
-        enumerator.get(),
+        *successor_cache,
+        *policy_cache,
+        start_condition->get(),
+        unsafety_condition->get(),
+        start_sampler.get(),
+        rng_streams->derive(TESTING_STREAMS).derive(num_testing_phases++),
+        *envelope,
+        trajectory_log.get(),
         *searchStatistics,
         per_iteration_stats.get(),
         terminate_cycles,
         use_policy_run_sampling);
 }
 
+std::unique_ptr<SplittingSearch> SafeStartGenerator::get_splitting_search() {
+    return std::make_unique<SplittingSearch>(
+        config,
+        deadline.limit(testing_time_limit),
+        *sim_env,
+        *successor_cache,
+        *policy_cache,
+        unsafety_condition->get(),
+        start_sampler.get(),
+        rng_streams->derive(TESTING_STREAMS).derive(num_testing_phases++),
+        *envelope,
+        *searchStatistics,
+        per_iteration_stats.get());
+}
+
+/// estimates the unsafe rate of the policy from the final start condition by rollouts.
+void SafeStartGenerator::validate_start_condition() {
+    PLAJA_LOG("Validating start condition...")
+    StartValidation validation(
+        config,
+        *model,
+        policy_cache->get_policy(),
+        get_policy_loader(),
+        *get_property_info().get_reach(), // the refined unsafety condition also holds on states proven unsafe.
+        num_threads,
+        validation_rollouts,
+        rng_streams->derive(VALIDATION_STREAMS).derive(current_property),
+        deadline);
+    const auto result = validation.validate(*enumerator);
+    if (per_iteration_stats) { per_iteration_stats->set_validation(result); }
+}
+
+std::unique_ptr<EnvelopeExplorer> SafeStartGenerator::get_envelope_explorer() const {
+    return std::make_unique<EnvelopeExplorer>(
+        config,
+        *model,
+        policy_cache->get_policy(),
+        get_policy_loader(),
+        start_condition->get(),
+        unsafety_condition->get(),
+        *searchStatistics,
+        per_iteration_stats.get(),
+        num_threads,
+        PLAJA_OPTION::START_GENERATOR::get_int_option(config, PLAJA_OPTION::max_explored_states),
+        deadline);
+}
+
+StartGenerator::PolicyLoader SafeStartGenerator::get_policy_loader() const {
+    // a copy, as repeated loads may return the same instance.
+    return [this]() { return std::make_unique<Policy>(propertyInfo->get_nn_interface()->load_policy(config)); };
+}
+
+std::vector<std::size_t> SafeStartGenerator::parse_property_indices(const std::string& indices) {
+    std::vector<std::size_t> result;
+    std::stringstream stream(indices);
+    std::string index;
+    while (std::getline(stream, index, ',')) {
+        if (not index.empty()) { result.push_back(std::stoul(index)); }
+    }
+    if (result.empty()) { throw std::invalid_argument("No property indices given: " + indices); }
+    return result;
+}
+
 std::unique_ptr<VerificationMethod> SafeStartGenerator::get_verification_method() const {
     return VerificationMethods::VerificationMethodFactory::create(
         verification_type,
@@ -186,15 +468,33 @@ std::unique_ptr<VerificationMethod> SafeStartGenerator::get_verification_method(
         per_iteration_stats.get());
 }
 
+std::vector<std::vector<int>> SafeStartGenerator::get_valuations(const std::unordered_set<StateID_type>& ids) const {
+    std::vector<std::vector<int>> valuations;
+    valuations.reserve(ids.size());
+    for (const auto id: ids) {
+        auto valuation = StartGenerator::to_valuation(sim_env->get_state(id));
+        valuation.erase(valuation.begin()); // loc variable.
+        valuations.push_back(std::move(valuation));
+    }
+    return valuations;
+}
+
 std::unordered_set<std::unique_ptr<StateBase>> SafeStartGenerator::get_unsafe_states(
-    const std::unordered_set<StateID_type>& ids) const {
+    const std::unordered_set<StateID_type>& ids) {
     std::unordered_set<std::unique_ptr<StateBase>> states;
-    for (auto id: ids) { states.emplace(sim_env->get_state(id).to_ptr()); }
+    for (auto id: ids) {
+        const auto& state = *states.emplace(sim_env->get_state(id).to_ptr()).first;
+        if (unsafe_box) { unsafe_box->add(*state); }
+    }
     return states;
 }
 
 void SafeStartGenerator::dump_iteration_stats() const {
-    if (per_iteration_stats) { per_iteration_stats->dump_to_csv(); }
+    if (not per_iteration_stats) { return; }
+    per_iteration_stats->set_condition_metrics(
+        StartGenerator::ConditionMetrics::of(start_condition->get()),
+        StartGenerator::ConditionMetrics::of(unsafety_condition->get()));
+    per_iteration_stats->dump_to_csv();
 }
 
 void SafeStartGenerator::print_statistics() const { searchStatistics->print_statistics(); }
@@ -6,13 +6,28 @@
 #define SAFE_START_GENERATOR_H
 #include "../../parser/ast/expression/expression.h"
 #include "../fd_adaptions/search_engine.h"
+#include "approximation_methods/box_accumulator.h"
+#include "deadline.h"
+#include "decision_diagrams/condition_diagrams.h"
 #include "start_generation_statistics.h"
+#include "strengthening_strategy/junction_condition.h"
+#include "strengthening_strategy/start_emptiness_check.h"
 #include "strengthening_strategy/strengthening_strategy.h"
+#include "testing/policy_cache.h"
+#include "testing/policy_envelope.h"
+#include "testing/envelope_explorer.h"
+#include "testing/rng_stream.h"
+#include "testing/testing_mode.h"
+#include "testing/successor_cache.h"
+#include "testing/trajectory_log.h"
+#include "testing/splitting_search.h"
+#include "testing/start_validation.h"
 #include "testing/unsafe_path_identifier.h"
 #include "verification_methods/verification_method.h"
 #include "verification_methods/verification_types.h"
 
 class InitialStatesEnumerator;
+class PropertyInformation;
 /**
  * @brief A search engine that generates a safe start condition.
  *
@@ -41,6 +56,7 @@ private:
     VerificationMethods::Type verification_type;
     std::unique_ptr<StrengtheningStrategy> strengthening_strategy;
     const bool alternating_mode;
+    Approximation::Type approximation_type;
     bool approximate_testing;
     bool approximate_verification;
 
@@ -48,40 +64,93 @@ private:
         Testing,
         Verification,
         CheckStart,
+        StartEmpty, // a refinement emptied the start condition.
     };
 
     Mode iteration_mode;
 
+    /// share of the engine time limit reserved for reporting the best-effort result.
+    static constexpr double deadline_reserve = 0.05;
+    StartGenerator::Deadline engine_deadline;
+    StartGenerator::Deadline deadline; // of the current property, passed to all phases.
+
+    // Batch mode: properties are processed one after another.
+    std::vector<std::size_t> property_indices;                          // model property indices.
+    std::vector<std::unique_ptr<PropertyInformation>> batch_properties; // empty for a single property.
+    std::size_t current_property = 0;
+    std::vector<SearchStatus> property_results;
+    [[nodiscard]] bool is_batch() const { return not batch_properties.empty(); }
+    /// @return the property currently processed.
+    [[nodiscard]] const PropertyInformation& get_property_info() const;
+
     // Engine Data
-    std::unique_ptr<Expression> start_condition;
-    std::unique_ptr<Expression> unsafety_condition;
+    std::unique_ptr<StartGenerator::JunctionCondition> start_condition;    // refined in place.
+    std::unique_ptr<StartGenerator::JunctionCondition> unsafety_condition; // refined in place.
 
     // Components
     std::unique_ptr<InitialStatesEnumerator> enumerator;
+    std::unique_ptr<StartGenerator::StartSampler> start_sampler; // of the testing phase, seeded by counterexamples.
+    std::unique_ptr<StartGenerator::StartCoverage> start_coverage; // optional, start states tested so far.
     std::unique_ptr<SimulationEnvironment> sim_env;
+    std::unique_ptr<StartGenerator::RngStreamFactory> rng_streams;
+    /// independent families of random number streams, keyed so results do not depend on the order of requests.
+    enum RngFamily : uint64_t { START_SAMPLING_STREAMS, TESTING_STREAMS, VALIDATION_STREAMS };
+    std::size_t num_testing_phases = 0; // keys the streams of the next testing phase.
+    std::unique_ptr<StartGenerator::SuccessorCache> successor_cache; // shared by all testing phases.
+    std::unique_ptr<StartGenerator::PolicyCache> policy_cache;       // shared by all testing phases.
+    std::unique_ptr<StartGenerator::PolicyEnvelope> envelope;        // shared by all testing phases.
+    std::unique_ptr<StartGenerator::TrajectoryLog> trajectory_log;   // optional, shared by all testing phases.
+    std::unique_ptr<StartGenerator::BoxAccumulator> unsafe_box; // optional, of the current testing phase.
+    std::unique_ptr<StartGenerator::ConditionDiagrams> condition_diagrams; // optional exact view of the conditions.
+    std::unique_ptr<StartGenerator::StartEmptinessCheck> emptiness_check;  // used without condition diagrams.
+    std::unique_ptr<VerificationMethod> verification_method;                // shared by all properties.
 
     // Statistics
     std::unique_ptr<StartGenerationStatistics> per_iteration_stats;
 
     // testing options
     bool use_testing = false;
+    Testing::Mode testing_mode = Testing::Mode::Rollout;
     int testing_time_limit = 0;
     bool use_policy_run_sampling = false;
     bool terminate_cycles = false;
 
+    /// policy rollouts from the final start condition, 0 to skip validation.
+    int validation_rollouts = 0;
+    /// of exhaustive exploration and validation.
+    unsigned num_threads = 1;
+
     void increase_testing_time_limit() {
         testing_time_limit *= 2;
         if (testing_time_limit > 1800) { testing_time_limit = 1800; }
     }
 
     // Helpers
+    void init_property();
+    SearchStatus step_property();
+    [[nodiscard]] SearchStatus finish_batch() const;
+    /// @return indices of a comma-separated list, e.g., "1,3,4".
+    static std::vector<std::size_t> parse_property_indices(const std::string& indices);
     Mode run_testing();
     Mode run_verification();
     SearchStatus check_start_condition();
+    SearchStatus report_start_condition(bool found);
+    void validate_start_condition();
+    /// reports the current start condition as unverified best-effort result.
+    SearchStatus report_timeout();
+    /// @return true if the start condition is empty, checked after each refinement.
+    [[nodiscard]] bool is_start_empty() const;
     std::unique_ptr<UnsafePathIdentifier> get_unsafe_path_identifier();
+    std::unique_ptr<SplittingSearch> get_splitting_search();
+    [[nodiscard]] std::unique_ptr<EnvelopeExplorer> get_envelope_explorer() const;
+    /// for components evaluating the policy on several threads.
+    [[nodiscard]] StartGenerator::PolicyLoader get_policy_loader() const;
     [[nodiscard]] std::unique_ptr<VerificationMethod> get_verification_method() const;
+    /// @return valuations of the states excluding loc variable.
+    [[nodiscard]] std::vector<std::vector<int>> get_valuations(const std::unordered_set<StateID_type>& ids) const;
+    /// also accumulates the bounds of the states for the bounding box approximation.
     [[nodiscard]] std::unordered_set<std::unique_ptr<StateBase>> get_unsafe_states(
-        const std::unordered_set<StateID_type>& ids) const;
+        const std::unordered_set<StateID_type>& ids);
 };
 
 #endif //SAFE_START_GENERATOR_H
@@ -7,9 +7,11 @@
 #include "../../exception/not_implemented_exception.h"
 #include "../../search/fd_adaptions/search_statistics.h"
 #include "../../stats/stats_base.h"
+#include "../states/state_base.h"
 #include <fstream>
 #include <numeric>
 #include <sstream>
+#include <unistd.h>
 
 StartGenerationStatistics::StartGenerationStatistics(const std::string& file):
     file(file) {
@@ -88,6 +90,24 @@ void StartGenerationStatistics::reset() {
     unsafety_eval = 0;
     sampling_timelimit_reached = 0;
     box_size = 0;
+    successor_cache_hit_rate = 0;
+    policy_cache_hit_rate = 0;
+    propagated_unsafe_states = 0;
+    start_region_size = -1;
+    verification_winner = "";
+    input_parts = -1;
+    start_metrics = {};
+    unsafety_metrics = {};
+    unsafe_states_bytes = 0;
+    rollout_state_rate = -1;
+    splitting_state_rate = -1;
+    exploration_complete = -1;
+    seeded_starts = 0;
+    sampled_starts = -1;
+    distinct_starts = -1;
+    coverage_fill = -1;
+    validated = false;
+    validation = {};
 }
 
 void StartGenerationStatistics::testing_iteration() {
@@ -98,12 +118,88 @@ void StartGenerationStatistics::verification_iteration() {
     iteration_mode = "Verification";
 }
 
+void StartGenerationStatistics::set_property(const size_t property_index) {
+    property = property_index;
+    start_condition_safe = "UNKNOWN";
+}
+
 void StartGenerationStatistics::set_start_condition_status(const bool safe) {
     iteration_mode = "Start_Checking";
     if (safe) {start_condition_safe = "SAFE";}
     else {start_condition_safe = "NOT_SAFE";}
 }
 
+void StartGenerationStatistics::set_start_condition_unverified() {
+    iteration_mode = "Start_Checking";
+    start_condition_safe = "UNVERIFIED";
+}
+
+void StartGenerationStatistics::set_successor_cache_hit_rate(const double hit_rate) {
+    successor_cache_hit_rate = hit_rate;
+}
+
+void StartGenerationStatistics::set_policy_cache_hit_rate(const double hit_rate) { policy_cache_hit_rate = hit_rate; }
+
+void StartGenerationStatistics::set_propagated_unsafe_states(const size_t num_states) {
+    propagated_unsafe_states = num_states;
+}
+
+void StartGenerationStatistics::set_start_region_size(const double relative_size) {
+    start_region_size = relative_size;
+}
+
+void StartGenerationStatistics::set_verification_winner(const std::string& method) { verification_winner = method; }
+
+void StartGenerationStatistics::set_input_parts(const std::size_t num_parts) {
+    input_parts = static_cast<long>(num_parts);
+}
+
+void StartGenerationStatistics::set_condition_metrics(
+    const StartGenerator::ConditionMetrics& start,
+    const StartGenerator::ConditionMetrics& unsafety) {
+    start_metrics = start;
+    unsafety_metrics = unsafety;
+}
+
+/// approximates the bytes of the state set: the state objects, their integer variables and the hash set nodes.
+void StartGenerationStatistics::set_unsafe_states(const std::unordered_set<std::unique_ptr<StateBase>>& states) {
+    unsafe_states_bytes = states.bucket_count() * sizeof(void*);
+    for (const auto& state: states) {
+        unsafe_states_bytes += sizeof(StateBase) + state->get_int_state_size() * sizeof(int) + 2 * sizeof(void*);
+    }
+}
+
+void StartGenerationStatistics::set_unsafe_state_rates(const double rollout_rate, const double splitting_rate) {
+    rollout_state_rate = rollout_rate;
+    splitting_state_rate = splitting_rate;
+}
+
+void StartGenerationStatistics::set_exploration_complete(const bool complete) { exploration_complete = complete; }
+
+void StartGenerationStatistics::set_seeded_starts(const std::size_t num_states) { seeded_starts = num_states; }
+
+void StartGenerationStatistics::set_start_coverage(
+    const std::size_t num_samples,
+    const std::size_t num_distinct,
+    const double fill_ratio) {
+    sampled_starts = static_cast<long>(num_samples);
+    distinct_starts = static_cast<long>(num_distinct);
+    coverage_fill = fill_ratio;
+}
+
+void StartGenerationStatistics::set_validation(const StartGenerator::ValidationResult& result) {
+    validated = true;
+    validation = result;
+}
+
+/// reads /proc/self/statm, hence only available on Linux.
+std::size_t StartGenerationStatistics::resident_set_bytes() {
+    std::ifstream statm("/proc/self/statm");
+    std::size_t size_pages = 0;
+    std::size_t resident_pages = 0;
+    if (not(statm >> size_pages >> resident_pages)) { return 0; }
+    return resident_pages * static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+}
 
 void StartGenerationStatistics::dump_to_csv() {
     if (not header_written) {
@@ -111,6 +207,7 @@ void StartGenerationStatistics::dump_to_csv() {
         header_written = true;
     }
     file << iteration << PLAJA_UTILS::commaString;
+    file << property << PLAJA_UTILS::commaString;
     file << iteration_mode << PLAJA_UTILS::commaString;
     file << unsafe_states << PLAJA_UTILS::commaString;
     file << search_time << PLAJA_UTILS::commaString;
@@ -118,6 +215,51 @@ void StartGenerationStatistics::dump_to_csv() {
     file << unsafety_eval << PLAJA_UTILS::commaString;
     file << sampling_timelimit_reached << PLAJA_UTILS::commaString;
     file << box_size << PLAJA_UTILS::commaString;
+    file << successor_cache_hit_rate << PLAJA_UTILS::commaString;
+    file << policy_cache_hit_rate << PLAJA_UTILS::commaString;
+    file << propagated_unsafe_states << PLAJA_UTILS::commaString;
+    file << start_region_size << PLAJA_UTILS::commaString;
+    file << verification_winner << PLAJA_UTILS::commaString;
+    file << input_parts << PLAJA_UTILS::commaString;
+    for (const auto* metrics: { &start_metrics, &unsafety_metrics }) {
+        file << metrics->nodes << PLAJA_UTILS::commaString;
+        file << metrics->depth << PLAJA_UTILS::commaString;
+        file << metrics->conjuncts << PLAJA_UTILS::commaString;
+        file << metrics->disjuncts << PLAJA_UTILS::commaString;
+        file << metrics->bytes << PLAJA_UTILS::commaString;
+    }
+    file << unsafe_states_bytes << PLAJA_UTILS::commaString;
+    file << resident_set_bytes() << PLAJA_UTILS::commaString;
+    file << rollout_state_rate << PLAJA_UTILS::commaString;
+    file << splitting_state_rate << PLAJA_UTILS::commaString;
+    file << exploration_complete << PLAJA_UTILS::commaString;
+    file << seeded_starts << PLAJA_UTILS::commaString;
+    file << sampled_starts << PLAJA_UTILS::commaString;
+    file << distinct_starts << PLAJA_UTILS::commaString;
+    file << (sampled_starts > 0 ? static_cast<double>(distinct_starts) / sampled_starts : -1)
+         << PLAJA_UTILS::commaString;
+    file << coverage_fill << PLAJA_UTILS::commaString;
+    if (validated) {
+        file << validation.rollouts << PLAJA_UTILS::commaString;
+        file << validation.unsafe << PLAJA_UTILS::commaString;
+        file << validation.rate() << PLAJA_UTILS::commaString;
+        file << validation.lower << PLAJA_UTILS::commaString;
+        file << validation.upper << PLAJA_UTILS::commaString;
+    } else {
+        for (int i = 0; i < 5; ++i) { file << -1 << PLAJA_UTILS::commaString; }
+    }
+    // traces separated by '|', states by ';' and values by ' ', so that the column stays a single CSV field.
+    for (std::size_t t = 0; t < validation.traces.size(); ++t) {
+        if (t > 0) { file << '|'; }
+        for (std::size_t s = 0; s < validation.traces[t].size(); ++s) {
+            if (s > 0) { file << ';'; }
+            for (std::size_t v = 0; v < validation.traces[t][s].size(); ++v) {
+                if (v > 0) { file << ' '; }
+                file << validation.traces[t][s][v];
+            }
+        }
+    }
+    file << PLAJA_UTILS::commaString;
     file << start_condition_safe;
     file << std::endl;
     iteration++;
@@ -127,6 +269,7 @@ void StartGenerationStatistics::dump_to_csv() {
 void StartGenerationStatistics::dump_names_to_csv() {
     const std::list<std::string> headers = {
         "Iteration",
+        "Property",
         "IterationMode",
         "UnsafeStates",
         "SearchTime",
@@ -134,6 +277,38 @@ void StartGenerationStatistics::dump_names_to_csv() {
         "UnsafetyEval",
         "SamplingTimeLimitReached",
         "BoxSize",
+        "SuccessorCacheHitRate",
+        "PolicyCacheHitRate",
+        "PropagatedUnsafeStates",
+        "StartRegionSize",
+        "VerificationWinner",
+        "InputParts",
+        "StartNodes",
+        "StartDepth",
+        "StartConjuncts",
+        "StartDisjuncts",
+        "StartBytes",
+        "UnsafetyNodes",
+        "UnsafetyDepth",
+        "UnsafetyConjuncts",
+        "UnsafetyDisjuncts",
+        "UnsafetyBytes",
+        "UnsafeStatesBytes",
+        "ResidentSetBytes",
+        "RolloutStateRate",
+        "SplittingStateRate",
+        "ExplorationComplete",
+        "SeededStarts",
+        "SampledStarts",
+        "DistinctStarts",
+        "StartCoverage",
+        "CoverageFill",
+        "ValidationRollouts",
+        "ValidationUnsafe",
+        "ValidationUnsafeRate",
+        "ValidationLower",
+        "ValidationUpper",
+        "ValidationTraces",
         "StartConditionSafe",
     };
 
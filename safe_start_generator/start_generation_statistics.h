@@ -9,15 +9,20 @@
 #include "../../stats/stats_base.h"
 #include "../../stats/stats_unsigned.h"
 #include "../../utils/default_constructors.h"
+#include "strengthening_strategy/condition_metrics.h"
+#include "testing/start_validation.h"
 
 #include <fstream>
+#include <memory>
 #include <string>
+#include <unordered_set>
 #include <vector>
 
 namespace PLAJA {
     enum class StatsDouble;
     class StatsBase;
 } // namespace PLAJA
+class StateBase;
 
 class StartGenerationStatistics final: public PLAJA::StatsBase {
 
@@ -26,6 +31,7 @@ private:
     bool header_written = false;
     //
     size_t iteration = 0;
+    size_t property = 1; // model property index, changes in batch mode.
     std::string iteration_mode;
     size_t unsafe_states = 0;
     double search_time = 0; // time of testing or verification.
@@ -33,7 +39,29 @@ private:
     double unsafety_eval = 0;
     size_t sampling_timelimit_reached = 0;
     double box_size = 0;
+    double successor_cache_hit_rate = 0;
+    double policy_cache_hit_rate = 0;
+    size_t propagated_unsafe_states = 0;
+    double start_region_size = -1; // relative to the state space, only known with decision diagrams.
     std::string start_condition_safe = "UNKNOWN";
+    std::string verification_winner; // method whose result was used, with the portfolio.
+    long input_parts = -1; // parts of the input-split policy queries, -1 without input splitting.
+    /* Memory */
+    StartGenerator::ConditionMetrics start_metrics;
+    StartGenerator::ConditionMetrics unsafety_metrics;
+    std::size_t unsafe_states_bytes = 0; // approximate, of the unsafe states found in the iteration.
+    /* Splitting: distinct unsafe states per second */
+    double rollout_state_rate = -1;
+    double splitting_state_rate = -1;
+    int exploration_complete = -1; // whether exhaustive exploration was exact, -1 with other testing modes.
+    std::size_t seeded_starts = 0; // start states drawn from counterexample neighborhoods.
+    /* Start coverage: -1 without coverage filter */
+    long sampled_starts = -1;  // including redrawn duplicates.
+    long distinct_starts = -1; // not tested in an earlier draw.
+    double coverage_fill = -1; // share of set bits of the filter, its false positive rate grows with it.
+    /* Validation of the final start condition */
+    bool validated = false;
+    StartGenerator::ValidationResult validation;
 
     void dump_names_to_csv();
 
@@ -52,7 +80,28 @@ public:
     void testing_iteration();
     void verification_iteration();
 
+    void set_property(size_t property_index);
     void set_start_condition_status(bool safe);
+    /// start condition returned as best-effort result at the deadline.
+    void set_start_condition_unverified();
+    void set_successor_cache_hit_rate(double hit_rate);
+    void set_policy_cache_hit_rate(double hit_rate);
+    void set_propagated_unsafe_states(size_t num_states);
+    void set_start_region_size(double relative_size);
+    void set_verification_winner(const std::string& method);
+    void set_input_parts(std::size_t num_parts);
+    void set_condition_metrics(
+        const StartGenerator::ConditionMetrics& start,
+        const StartGenerator::ConditionMetrics& unsafety);
+    void set_unsafe_states(const std::unordered_set<std::unique_ptr<StateBase>>& states);
+    void set_unsafe_state_rates(double rollout_rate, double splitting_rate);
+    void set_exploration_complete(bool complete);
+    void set_seeded_starts(std::size_t num_states);
+    void set_start_coverage(std::size_t num_samples, std::size_t num_distinct, double fill_ratio);
+    void set_validation(const StartGenerator::ValidationResult& result);
+
+    /// @return resident set size of the process in bytes, 0 if unknown.
+    static std::size_t resident_set_bytes();
 
     // output
     // void print_statistics() const;
@@ -0,0 +1,203 @@
+//
+// Created by Daniel Sherbakov in 2025.
+//
+
+#include "start_generator_options.h"
+
+#include "../../option_parser/option_parser_aux.h"
+#include "../factories/configuration.h"
+
+#include <unordered_map>
+
+namespace PLAJA_OPTION {
+
+    const std::string properties("properties");
+
+    const std::string input_splitting("input_splitting");
+    const std::string split_timeout("split_timeout");
+
+    const std::string use_decision_diagrams("use_decision_diagrams");
+    const std::string max_boxes("max_boxes");
+    const std::string box_coverage("box_coverage");
+
+    const std::string testing_mode("testing_mode");
+    const std::string num_threads("num_threads");
+    const std::string max_explored_states("max_explored_states");
+    const std::string splitting_levels("splitting_levels");
+    const std::string splitting_factor("splitting_factor");
+    const std::string splitting_calibration("splitting_calibration");
+    const std::string seed_fraction("seed_fraction");
+    const std::string seed_radius("seed_radius");
+    const std::string max_start_resamples("max_start_resamples");
+    const std::string trajectory_log("trajectory_log");
+    const std::string validation_rollouts("validation_rollouts");
+
+} // namespace PLAJA_OPTION
+
+namespace PLAJA_OPTION_DEFAULT {
+
+    constexpr int input_splitting = 0; // off.
+    constexpr double split_timeout = 1;
+
+    constexpr int max_boxes = 8;
+    constexpr int box_coverage = 100; // percent.
+
+    constexpr int num_threads = 1;
+    constexpr int max_explored_states = 1000000;
+    constexpr int splitting_levels = 4;
+    constexpr int splitting_factor = 2;
+    constexpr double seed_fraction = 0; // uniform.
+    constexpr double seed_radius = 0.05;
+    constexpr int max_start_resamples = 0; // off.
+    constexpr int validation_rollouts = 0; // off.
+
+} // namespace PLAJA_OPTION_DEFAULT
+
+namespace PLAJA_OPTION::START_GENERATOR {
+
+    void add_options(PLAJA::OptionParser& option_parser) {
+        OPTION_PARSER::add_value_option(option_parser, PLAJA_OPTION::properties);
+
+        OPTION_PARSER::add_int_option(
+            option_parser,
+            PLAJA_OPTION::input_splitting,
+            PLAJA_OPTION_DEFAULT::input_splitting);
+        OPTION_PARSER::add_double_option(
+            option_parser,
+            PLAJA_OPTION::split_timeout,
+            PLAJA_OPTION_DEFAULT::split_timeout);
+
+        OPTION_PARSER::add_flag(option_parser, PLAJA_OPTION::use_decision_diagrams);
+        OPTION_PARSER::add_int_option(option_parser, PLAJA_OPTION::max_boxes, PLAJA_OPTION_DEFAULT::max_boxes);
+        OPTION_PARSER::add_int_option(option_parser, PLAJA_OPTION::box_coverage, PLAJA_OPTION_DEFAULT::box_coverage);
+
+        OPTION_PARSER::add_value_option(option_parser, PLAJA_OPTION::testing_mode);
+        OPTION_PARSER::add_int_option(option_parser, PLAJA_OPTION::num_threads, PLAJA_OPTION_DEFAULT::num_threads);
+        OPTION_PARSER::add_int_option(
+            option_parser,
+            PLAJA_OPTION::max_explored_states,
+            PLAJA_OPTION_DEFAULT::max_explored_states);
+        OPTION_PARSER::add_int_option(
+            option_parser,
+            PLAJA_OPTION::splitting_levels,
+            PLAJA_OPTION_DEFAULT::splitting_levels);
+        OPTION_PARSER::add_int_option(
+            option_parser,
+            PLAJA_OPTION::splitting_factor,
+            PLAJA_OPTION_DEFAULT::splitting_factor);
+        OPTION_PARSER::add_flag(option_parser, PLAJA_OPTION::splitting_calibration);
+        OPTION_PARSER::add_double_option(
+            option_parser,
+            PLAJA_OPTION::seed_fraction,
+            PLAJA_OPTION_DEFAULT::seed_fraction);
+        OPTION_PARSER::add_double_option(option_parser, PLAJA_OPTION::seed_radius, PLAJA_OPTION_DEFAULT::seed_radius);
+        OPTION_PARSER::add_int_option(
+            option_parser,
+            PLAJA_OPTION::max_start_resamples,
+            PLAJA_OPTION_DEFAULT::max_start_resamples);
+        OPTION_PARSER::add_value_option(option_parser, PLAJA_OPTION::trajectory_log);
+        OPTION_PARSER::add_int_option(
+            option_parser,
+            PLAJA_OPTION::validation_rollouts,
+            PLAJA_OPTION_DEFAULT::validation_rollouts);
+    }
+
+    void print_options() {
+        OPTION_PARSER::print_value_option(
+            PLAJA_OPTION::properties,
+            "<indices>",
+            "Comma-separated property indices, processed one after another against the same policy.");
+
+        OPTION_PARSER::print_int_option(
+            PLAJA_OPTION::input_splitting,
+            PLAJA_OPTION_DEFAULT::input_splitting,
+            "Number of Marabou solvers checking parts of the input domain of a policy query in parallel, 0 for none.");
+        OPTION_PARSER::print_double_option(
+            PLAJA_OPTION::split_timeout,
+            PLAJA_OPTION_DEFAULT::split_timeout,
+            "Seconds after which a part of an input-split query is halved along its widest dimension.");
+
+        OPTION_PARSER::print_flag(
+            PLAJA_OPTION::use_decision_diagrams,
+            "Represent the start and unsafety conditions as interval decision diagrams.");
+        OPTION_PARSER::print_int_option(
+            PLAJA_OPTION::max_boxes,
+            PLAJA_OPTION_DEFAULT::max_boxes,
+            "Maximal number of boxes of the multi_under approximation.");
+        OPTION_PARSER::print_int_option(
+            PLAJA_OPTION::box_coverage,
+            PLAJA_OPTION_DEFAULT::box_coverage,
+            "Percentage of unsafe states the boxes of the multi_under approximation have to cover.");
+
+        OPTION_PARSER::print_value_option(
+            PLAJA_OPTION::testing_mode,
+            "<rollout|exhaustive|splitting>",
+            "Testing by policy rollouts (default), exhaustive envelope exploration, or multilevel splitting.");
+        OPTION_PARSER::print_int_option(
+            PLAJA_OPTION::num_threads,
+            PLAJA_OPTION_DEFAULT::num_threads,
+            "Threads of exhaustive exploration and validation.");
+        OPTION_PARSER::print_int_option(
+            PLAJA_OPTION::max_explored_states,
+            PLAJA_OPTION_DEFAULT::max_explored_states,
+            "State limit of exhaustive exploration, beyond the result is not exact.");
+        OPTION_PARSER::print_int_option(
+            PLAJA_OPTION::splitting_levels,
+            PLAJA_OPTION_DEFAULT::splitting_levels,
+            "Number of distance thresholds of multilevel splitting.");
+        OPTION_PARSER::print_int_option(
+            PLAJA_OPTION::splitting_factor,
+            PLAJA_OPTION_DEFAULT::splitting_factor,
+            "Number of trajectories a trajectory is split into at a threshold.");
+        OPTION_PARSER::print_flag(
+            PLAJA_OPTION::splitting_calibration,
+            "Spend the first 10% of each splitting phase on plain rollouts and report both unsafe state rates.");
+        OPTION_PARSER::print_double_option(
+            PLAJA_OPTION::seed_fraction,
+            PLAJA_OPTION_DEFAULT::seed_fraction,
+            "Fraction of start state draws perturbing a recent counterexample.");
+        OPTION_PARSER::print_double_option(
+            PLAJA_OPTION::seed_radius,
+            PLAJA_OPTION_DEFAULT::seed_radius,
+            "Perturbation radius as a fraction of each variable domain.");
+        OPTION_PARSER::print_int_option(
+            PLAJA_OPTION::max_start_resamples,
+            PLAJA_OPTION_DEFAULT::max_start_resamples,
+            "Redraws of start states tested before, 0 to not track tested start states.");
+        OPTION_PARSER::print_value_option(
+            PLAJA_OPTION::trajectory_log,
+            "<file>",
+            "Binary log of all testing trajectories.");
+        OPTION_PARSER::print_int_option(
+            PLAJA_OPTION::validation_rollouts,
+            PLAJA_OPTION_DEFAULT::validation_rollouts,
+            "Policy rollouts validating the final start condition, 0 to skip validation.");
+    }
+
+    int get_int_option(const PLAJA::Configuration& config, const std::string& option) {
+        if (config.has_int_option(option)) { return config.get_int_option(option); }
+        static const std::unordered_map<std::string, int> defaults {
+            { PLAJA_OPTION::input_splitting, PLAJA_OPTION_DEFAULT::input_splitting },
+            { PLAJA_OPTION::max_boxes, PLAJA_OPTION_DEFAULT::max_boxes },
+            { PLAJA_OPTION::box_coverage, PLAJA_OPTION_DEFAULT::box_coverage },
+            { PLAJA_OPTION::num_threads, PLAJA_OPTION_DEFAULT::num_threads },
+            { PLAJA_OPTION::max_explored_states, PLAJA_OPTION_DEFAULT::max_explored_states },
+            { PLAJA_OPTION::splitting_levels, PLAJA_OPTION_DEFAULT::splitting_levels },
+            { PLAJA_OPTION::splitting_factor, PLAJA_OPTION_DEFAULT::splitting_factor },
+            { PLAJA_OPTION::max_start_resamples, PLAJA_OPTION_DEFAULT::max_start_resamples },
+            { PLAJA_OPTION::validation_rollouts, PLAJA_OPTION_DEFAULT::validation_rollouts },
+        };
+        return defaults.at(option);
+    }
+
+    double get_double_option(const PLAJA::Configuration& config, const std::string& option) {
+        if (config.has_double_option(option)) { return config.get_double_option(option); }
+        static const std::unordered_map<std::string, double> defaults {
+            { PLAJA_OPTION::split_timeout, PLAJA_OPTION_DEFAULT::split_timeout },
+            { PLAJA_OPTION::seed_fraction, PLAJA_OPTION_DEFAULT::seed_fraction },
+            { PLAJA_OPTION::seed_radius, PLAJA_OPTION_DEFAULT::seed_radius },
+        };
+        return defaults.at(option);
+    }
+
+} // namespace PLAJA_OPTION::START_GENERATOR
@@ -0,0 +1,59 @@
+//
+// Created by Daniel Sherbakov in 2025.
+//
+
+#ifndef START_GENERATOR_OPTIONS_H
+#define START_GENERATOR_OPTIONS_H
+
+#include <string>
+
+namespace PLAJA {
+    class Configuration;
+    class OptionParser;
+}
+
+/**
+ * Options of the generator's extensions, i.e., those not part of PlaJA's safe start generator options.
+ * `add_options` has to be called next to the registration of the latter, so that all are known to the option parser.
+ * Until then, the int and double options are read by `get_int_option` and `get_double_option`, which fall back to the
+ * defaults.
+ */
+namespace PLAJA_OPTION {
+
+    // batch mode
+    extern const std::string properties;
+
+    // verification
+    extern const std::string input_splitting;
+    extern const std::string split_timeout;
+
+    // start condition representation
+    extern const std::string use_decision_diagrams;
+    extern const std::string max_boxes;
+    extern const std::string box_coverage;
+
+    // testing
+    extern const std::string testing_mode;
+    extern const std::string num_threads;
+    extern const std::string max_explored_states;
+    extern const std::string splitting_levels;
+    extern const std::string splitting_factor;
+    extern const std::string splitting_calibration;
+    extern const std::string seed_fraction;
+    extern const std::string seed_radius;
+    extern const std::string max_start_resamples;
+    extern const std::string trajectory_log;
+    extern const std::string validation_rollouts;
+
+    namespace START_GENERATOR {
+        extern void add_options(PLAJA::OptionParser& option_parser);
+        extern void print_options();
+        /// @return value of an int option above, its default if the option is not set or not registered.
+        extern int get_int_option(const PLAJA::Configuration& config, const std::string& option);
+        /// @return value of a double option above, its default if the option is not set or not registered.
+        extern double get_double_option(const PLAJA::Configuration& config, const std::string& option);
+    } // namespace START_GENERATOR
+
+} // namespace PLAJA_OPTION
+
+#endif //START_GENERATOR_OPTIONS_H
@@ -0,0 +1,49 @@
+//
+// Created by Daniel Sherbakov in 2025.
+//
+
+#ifndef STATE_VALUATION_H
+#define STATE_VALUATION_H
+
+#include "../information/model_information.h"
+#include "../states/state_base.h"
+#include "../states/state_values.h"
+
+#include <cstddef>
+#include <vector>
+
+/**
+ * Plain integer valuations of states, used where states have to outlive or be shared across simulation environments
+ * (e.g., between threads), or be stored compactly.
+ */
+namespace StartGenerator {
+
+    /// integer state values including the location variable at index 0.
+    using Valuation = std::vector<int>;
+
+    inline Valuation to_valuation(const StateBase& state) {
+        const auto size = state.get_int_state_size();
+        Valuation valuation(size);
+        for (std::size_t i = 0; i < size; ++i) { valuation[i] = state.get_int(i); }
+        return valuation;
+    }
+
+    inline StateValues to_state_values(const Valuation& valuation, const ModelInformation& model_info) {
+        auto state = model_info.get_initial_values();
+        for (std::size_t i = 0; i < valuation.size(); ++i) { state.assign_int<false>(i, valuation[i]); }
+        return state;
+    }
+
+    struct ValuationHash {
+        std::size_t operator()(const Valuation& valuation) const {
+            std::size_t seed = valuation.size();
+            for (const int value: valuation) {
+                seed ^= static_cast<std::size_t>(value) + 0x9E3779B97F4A7C15ULL + (seed << 6) + (seed >> 2);
+            }
+            return seed;
+        }
+    };
+
+} // namespace StartGenerator
+
+#endif //STATE_VALUATION_H
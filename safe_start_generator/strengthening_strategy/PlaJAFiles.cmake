@@ -1,4 +1,10 @@
 set(STRENGTHENING_STRATEGY_SOURCES
     ${CMAKE_CURRENT_LIST_DIR}/strengthening_strategy.cpp
     ${CMAKE_CURRENT_LIST_DIR}/strengthening_strategy.h
+    ${CMAKE_CURRENT_LIST_DIR}/junction_condition.cpp
+    ${CMAKE_CURRENT_LIST_DIR}/junction_condition.h
+    ${CMAKE_CURRENT_LIST_DIR}/start_emptiness_check.cpp
+    ${CMAKE_CURRENT_LIST_DIR}/start_emptiness_check.h
+    ${CMAKE_CURRENT_LIST_DIR}/condition_metrics.cpp
+    ${CMAKE_CURRENT_LIST_DIR}/condition_metrics.h
 )
\ No newline at end of file
@@ -0,0 +1,114 @@
+//
+// Created by Daniel Sherbakov in 2025.
+//
+
+#include "condition_metrics.h"
+
+#include "../../../parser/ast/expression/binary_op_expression.h"
+#include "../../../parser/ast/expression/bool_value_expression.h"
+#include "../../../parser/ast/expression/integer_value_expression.h"
+#include "../../../parser/ast/expression/real_value_expression.h"
+#include "../../../parser/ast/expression/special_cases/linear_expression.h"
+#include "../../../parser/ast/expression/special_cases/nary_expression.h"
+#include "../../../parser/ast/expression/unary_op_expression.h"
+#include "../../../parser/ast/expression/variable_expression.h"
+#include "../../../parser/visitor/ast_visitor_const.h"
+
+#include <algorithm>
+
+namespace {
+
+    /**
+     * Counts the expression nodes during the default traversal of the visitor.
+     * Nodes of other kinds than the ones below (e.g., if-then-else) are traversed, but not counted themselves, and a
+     * junction directly below one is taken as a continuation of the enclosing junction.
+     */
+    class MetricsVisitor final: public AstVisitorConst {
+    public:
+        StartGenerator::ConditionMetrics metrics;
+
+        void visit(const BinaryOpExpression* exp) override {
+            enter(sizeof(BinaryOpExpression));
+            traverse(exp, junction_of(exp->get_op()), 2);
+            leave();
+        }
+
+        void visit(const NaryExpression* exp) override {
+            enter(sizeof(NaryExpression) + exp->get_size() * sizeof(std::unique_ptr<Expression>));
+            traverse(exp, junction_of(exp->get_op()), exp->get_size());
+            leave();
+        }
+
+        void visit(const UnaryOpExpression* exp) override {
+            enter(sizeof(UnaryOpExpression));
+            traverse(exp, Junction::None, 0);
+            leave();
+        }
+
+        void visit(const LinearExpression* exp) override {
+            enter(sizeof(LinearExpression));
+            traverse(exp, Junction::None, 0);
+            leave();
+        }
+
+        void visit(const VariableExpression* /*exp*/) override { leaf(sizeof(VariableExpression)); }
+        void visit(const IntegerValueExpression* /*exp*/) override { leaf(sizeof(IntegerValueExpression)); }
+        void visit(const BoolValueExpression* /*exp*/) override { leaf(sizeof(BoolValueExpression)); }
+        void visit(const RealValueExpression* /*exp*/) override { leaf(sizeof(RealValueExpression)); }
+
+    private:
+        enum class Junction { None, Conjunction, Disjunction };
+
+        std::size_t current_depth = 0;
+        Junction parent = Junction::None; // of the node visited, None below nodes of other kinds.
+
+        template<typename Exp>
+        static Junction junction_of(const Exp op) {
+            if (op == BinaryOpExpression::AND) { return Junction::Conjunction; }
+            if (op == BinaryOpExpression::OR) { return Junction::Disjunction; }
+            return Junction::None;
+        }
+
+        /**
+         * Counts the operands of a junction and visits its children.
+         * Each junction node adds its operands but one, and the top of a chain of the same junction adds the last one,
+         * so that, e.g., a & (b & c) counts three conjuncts, the same as a & b & c.
+         */
+        template<typename Exp>
+        void traverse(const Exp* exp, const Junction junction, const std::size_t num_operands) {
+            if (junction != Junction::None and num_operands > 0) {
+                const auto operands = num_operands - 1 + (parent == junction ? 0 : 1);
+                if (junction == Junction::Conjunction) { metrics.conjuncts += operands; }
+                if (junction == Junction::Disjunction) { metrics.disjuncts += operands; }
+            }
+            const auto outer = parent;
+            parent = junction;
+            AstVisitorConst::visit(exp);
+            parent = outer;
+        }
+
+        void enter(const std::size_t bytes) {
+            ++metrics.nodes;
+            metrics.bytes += bytes;
+            metrics.depth = std::max(metrics.depth, ++current_depth);
+        }
+
+        void leave() { --current_depth; }
+
+        void leaf(const std::size_t bytes) {
+            enter(bytes);
+            leave();
+        }
+    };
+
+} // namespace
+
+namespace StartGenerator {
+
+    ConditionMetrics ConditionMetrics::of(const Expression& condition) {
+        MetricsVisitor visitor;
+        condition.accept(&visitor);
+        return visitor.metrics;
+    }
+
+} // namespace StartGenerator
@@ -0,0 +1,30 @@
+//
+// Created by Daniel Sherbakov in 2025.
+//
+
+#ifndef CONDITION_METRICS_H
+#define CONDITION_METRICS_H
+
+#include <cstddef>
+
+class Expression;
+
+namespace StartGenerator {
+
+    /**
+     * @brief Size of a condition expression, to track how the start and unsafety condition grow with refinement.
+     */
+    struct ConditionMetrics {
+        std::size_t nodes = 0;
+        std::size_t depth = 0;
+        std::size_t conjuncts = 0; // operands of conjunctions, a & (b & c) has three.
+        std::size_t disjuncts = 0; // operands of disjunctions, a | (b | c) has three.
+        std::size_t bytes = 0;     // approximate, the sizes of the node objects.
+
+        /// traverses the whole expression once.
+        static ConditionMetrics of(const Expression& condition);
+    };
+
+} // namespace StartGenerator
+
+#endif //CONDITION_METRICS_H
@@ -0,0 +1,38 @@
+//
+// Created by Daniel Sherbakov in 2025.
+//
+
+#include "junction_condition.h"
+
+#include "../../../parser/ast/expression/binary_op_expression.h"
+#include "../../../parser/ast/expression/special_cases/nary_expression.h"
+#include "../../../parser/visitor/to_normalform.h"
+
+#include <list>
+
+namespace StartGenerator {
+
+    JunctionCondition::JunctionCondition(std::unique_ptr<Expression> condition, const Junction junction):
+        junction(junction),
+        root(std::make_unique<NaryExpression>(
+            junction == Junction::Conjunction ? BinaryOpExpression::AND : BinaryOpExpression::OR)) {
+        append(std::move(condition));
+    }
+
+    JunctionCondition::~JunctionCondition() = default;
+
+    void JunctionCondition::append(std::unique_ptr<Expression> part) {
+        TO_NORMALFORM::normalize(part);
+        TO_NORMALFORM::specialize(part);
+        std::list<std::unique_ptr<Expression>> new_parts = junction == Junction::Conjunction
+                                                               ? TO_NORMALFORM::split_conjunction(std::move(part), false)
+                                                               : TO_NORMALFORM::split_disjunction(std::move(part), false);
+        for (auto& sub: new_parts) {
+            parts.push_back(sub.get());
+            root->add_sub(std::move(sub));
+        }
+    }
+
+    const Expression& JunctionCondition::get() const { return *root; }
+
+} // namespace StartGenerator
@@ -0,0 +1,55 @@
+//
+// Created by Daniel Sherbakov in 2025.
+//
+
+#ifndef JUNCTION_CONDITION_H
+#define JUNCTION_CONDITION_H
+
+#include "../../../utils/default_constructors.h"
+
+#include <memory>
+#include <vector>
+
+class Expression;
+class NaryExpression;
+
+namespace StartGenerator {
+
+    /**
+     * @brief Append-only conjunction or disjunction used for the start and unsafety condition.
+     *
+     * Refinement only ever adds exclusions to the start condition and inclusions to the unsafety condition.
+     * Parts are therefore appended to a flat n-ary root: only the appended part is normalized, and the existing
+     * parts are neither copied nor renormalized, so the cost of a refinement step does not grow with the size of the
+     * condition.
+     */
+    class JunctionCondition {
+    public:
+        enum class Junction {
+            Conjunction,
+            Disjunction,
+        };
+
+        /// splits condition into its top-level parts and normalizes each of them once.
+        JunctionCondition(std::unique_ptr<Expression> condition, Junction junction);
+        ~JunctionCondition();
+        DELETE_CONSTRUCTOR(JunctionCondition)
+
+        /// normalizes part and adds it (flattened, if of the same junction) to the root.
+        void append(std::unique_ptr<Expression> part);
+
+        [[nodiscard]] const Expression& get() const;
+        [[nodiscard]] std::size_t get_num_parts() const { return parts.size(); }
+
+        /// @return the index-th top-level part in order of appending, e.g., to add new parts to a solver incrementally.
+        [[nodiscard]] const Expression& get_part(const std::size_t index) const { return *parts[index]; }
+
+    private:
+        const Junction junction;
+        std::unique_ptr<NaryExpression> root;
+        std::vector<const Expression*> parts; // owned by root.
+    };
+
+} // namespace StartGenerator
+
+#endif //JUNCTION_CONDITION_H
@@ -0,0 +1,46 @@
+//
+// Created by Daniel Sherbakov in 2025.
+//
+
+#include "start_emptiness_check.h"
+
+#include "../../../globals.h"
+#include "../../factories/configuration.h"
+#include "../../smt/model/model_z3.h"
+#include "../../smt/solver/smt_solver_z3.h"
+#include "../../smt/solver/solution_z3.h" // removing this causes incomplete type error although not used.
+#include "../verification_methods/solver_time_limits.h"
+#include "junction_condition.h"
+
+#include <z3++.h>
+
+namespace StartGenerator {
+
+    StartEmptinessCheck::StartEmptinessCheck(const PLAJA::Configuration& config) {
+        if (!config.has_sharable(PLAJA::SharableKey::MODEL_Z3)) {
+            config.set_sharable(PLAJA::SharableKey::MODEL_Z3, std::make_shared<ModelZ3>(config));
+        }
+        model_z3 = config.get_sharable_as_const<ModelZ3>(PLAJA::SharableKey::MODEL_Z3);
+        solver = PLAJA_UTILS::cast_unique<Z3_IN_PLAJA::SMTSolver>(model_z3->init_solver(config, 0));
+    }
+
+    StartEmptinessCheck::~StartEmptinessCheck() = default;
+
+    /// An empty start condition ends the search, hence only a proof of unsatisfiability counts, not a timeout.
+    bool StartEmptinessCheck::is_empty(const JunctionCondition& start, const Deadline& deadline) {
+        // parts are never removed, so they are asserted at the base level of the solver.
+        for (; num_asserted < start.get_num_parts(); ++num_asserted) {
+            model_z3->add_to_solver(*solver, start.get_part(num_asserted), 0);
+        }
+        VerificationMethods::limit_checks(*solver, deadline);
+        switch (solver->_solver().check()) {
+            case z3::unsat: return true;
+            case z3::sat: return false;
+            default: {
+                PLAJA_LOG("Emptiness of the start condition unknown, treated as non-empty.")
+                return false;
+            }
+        }
+    }
+
+} // namespace StartGenerator
@@ -0,0 +1,49 @@
+//
+// Created by Daniel Sherbakov in 2025.
+//
+
+#ifndef START_EMPTINESS_CHECK_H
+#define START_EMPTINESS_CHECK_H
+
+#include "../../../utils/default_constructors.h"
+#include "../../smt/forward_smt_z3.h"
+#include "../deadline.h"
+
+#include <cstddef>
+#include <memory>
+
+namespace PLAJA {
+    class Configuration;
+}
+
+namespace StartGenerator {
+
+    class JunctionCondition;
+
+    /**
+     * @brief Incremental satisfiability check of the start condition.
+     *
+     * The solver context persists across refinements: as the start condition is an append-only conjunction, each check
+     * only asserts the parts appended since the previous check, so Z3 can reuse what it learned about the earlier ones.
+     */
+    class StartEmptinessCheck {
+    public:
+        explicit StartEmptinessCheck(const PLAJA::Configuration& config);
+        ~StartEmptinessCheck();
+        DELETE_CONSTRUCTOR(StartEmptinessCheck)
+
+        /**
+         * @brief The check is bounded by the deadline.
+         * @return true if no state satisfies the (conjunctive) start condition, false if one does or it is unknown.
+         */
+        [[nodiscard]] bool is_empty(const JunctionCondition& start, const Deadline& deadline);
+
+    private:
+        std::shared_ptr<const ModelZ3> model_z3;
+        std::unique_ptr<Z3_IN_PLAJA::SMTSolver> solver;
+        std::size_t num_asserted = 0; // parts of the start condition already in the solver.
+    };
+
+} // namespace StartGenerator
+
+#endif //START_EMPTINESS_CHECK_H
@@ -4,16 +4,20 @@
 
 #include "strengthening_strategy.h"
 
+#include "../../../assertions.h"
 #include "../../fd_adaptions/timer.h"
 #include "../../parser/ast/expression/expression.h"
 #include "../../parser/visitor/to_normalform.h"
 #include "../../states/state_values.h"
 #include "../approximation_methods/bounded_box.h"
 #include "../approximation_methods/bounding_box.h"
+#include "../approximation_methods/decision_tree.h"
+#include "../approximation_methods/multi_box.h"
+#include "../approximation_methods/template_polyhedron.h"
+#include "../decision_diagrams/condition_diagrams.h"
 #include "../start_generation_statistics.h"
 #include "../verification_methods/verification_types.h"
-
-#include <list>
+#include "junction_condition.h"
 
 using namespace VerificationMethods;
 
@@ -32,6 +36,7 @@ std::unique_ptr<StrengtheningStrategy> StrengtheningStrategy::create(
     StartGenerationStatistics* per_iter_stats) {
     switch (verification_type) {
         case Type::INVARIANT_STRENGTHENING:
+        case Type::PORTFOLIO:
             return std::make_unique<InvariantStrengtheningStrategy>(model, approximation_type, per_iter_stats);
         case Type::START_CONDITION_STRENGTHENING:
             return std::make_unique<StartConditionStrengtheningStrategy>(model, approximation_type, per_iter_stats);
@@ -40,17 +45,39 @@ std::unique_ptr<StrengtheningStrategy> StrengtheningStrategy::create(
 }
 
 std::unique_ptr<Expression> StrengtheningStrategy::get_box_approximation(
-    const std::unordered_set<std::unique_ptr<StateBase>>& set) {
+    const std::unordered_set<std::unique_ptr<StateBase>>& set,
+    const StartGenerator::BoxAccumulator* bounds,
+    BoundedBox::Corners& corners) {
     switch (approx) {
         case Approximation::Type::Overapproximation: {
             PLAJA_LOG("Over approximating ...")
-            auto rlt = BoundingBox::compute_bounding_box(set, model);
+            PLAJA_ASSERT(not bounds or bounds->size() == set.size())
+            std::unique_ptr<StartGenerator::BoxAccumulator> set_bounds;
+            if (not bounds) {
+                set_bounds = std::make_unique<StartGenerator::BoxAccumulator>(model);
+                for (const auto& state: set) { set_bounds->add(*state); }
+                bounds = set_bounds.get();
+            }
+            auto rlt = BoundingBox::compute_bounding_box(*bounds, model);
+            corners = BoundingBox::get_corners(*bounds, model);
             per_iter_stats->inc_attr_double(PLAJA::StatsDouble::BOX_SIZE, rlt.first);
             return std::move(rlt.second);
         }
         case Approximation::Type::Underapproximation: {
             PLAJA_LOG("Under approximating ...")
-            auto rlt = BoundedBox::compute_bounded_box(set, model);
+            auto rlt = BoundedBox::compute_bounded_box(set, model, &corners);
+            per_iter_stats->inc_attr_double(PLAJA::StatsDouble::BOX_SIZE, rlt.first);
+            return std::move(rlt.second);
+        }
+        case Approximation::Type::Octagon: {
+            PLAJA_LOG("Over approximating by octagon ...")
+            auto rlt = TemplatePolyhedron::compute_octagon(set, model);
+            per_iter_stats->inc_attr_double(PLAJA::StatsDouble::BOX_SIZE, rlt.first);
+            return std::move(rlt.second);
+        }
+        case Approximation::Type::Hull: {
+            PLAJA_LOG("Over approximating by template hull ...")
+            auto rlt = TemplatePolyhedron::compute_hull(set, model);
             per_iter_stats->inc_attr_double(PLAJA::StatsDouble::BOX_SIZE, rlt.first);
             return std::move(rlt.second);
         }
@@ -71,6 +98,73 @@ StartConditionStrengtheningStrategy::StartConditionStrengtheningStrategy(
     StartGenerationStatistics* per_iter_stats):
     StrengtheningStrategy(model, approximation_type, per_iter_stats) {}
 
+void StrengtheningStrategy::exclude_states(
+    StartGenerator::JunctionCondition& start_condition,
+    StartGenerator::JunctionCondition& unsafety_condition,
+    const bool approximate,
+    const std::unordered_set<std::unique_ptr<StateBase>>& states,
+    const StartGenerator::BoxAccumulator* bounds) {
+    if (approximate and (approx == Approximation::Type::MultiUnderapproximation or
+                         approx == Approximation::Type::DecisionTree)) {
+        MultiBox::Cover cover;
+        if (approx == Approximation::Type::MultiUnderapproximation) {
+            PLAJA_LOG("Under approximating with multiple boxes ...")
+            cover = MultiBox::compute_multi_box(states, model, max_boxes, box_coverage);
+        } else {
+            PLAJA_LOG("Approximating by decision tree ...")
+            cover = DecisionTree::compute_unsafe_leaves(states, safe_samples, model);
+        }
+        if (per_iter_stats) { per_iter_stats->inc_attr_double(PLAJA::StatsDouble::BOX_SIZE, cover.covered); }
+        for (std::size_t i = 0; i < cover.boxes.size(); ++i) {
+            exclude_box(start_condition, unsafety_condition, std::move(cover.boxes[i]), &cover.corners[i], states);
+        }
+        // leftover states in the same step.
+        for (const auto* state: cover.leftover) { exclude_state(start_condition, unsafety_condition, *state); }
+    } else if (approximate and approx != Approximation::Type::None) {
+        BoundedBox::Corners corners;
+        auto box = get_box_approximation(states, bounds, corners);
+        const bool is_box = not corners.first.empty();
+        exclude_box(start_condition, unsafety_condition, std::move(box), is_box ? &corners : nullptr, states);
+    } else {
+        for (const auto& state: states) { exclude_state(start_condition, unsafety_condition, *state); }
+    }
+}
+
+void StrengtheningStrategy::exclude_state(
+    StartGenerator::JunctionCondition& start_condition,
+    StartGenerator::JunctionCondition& unsafety_condition,
+    const StateBase& state) {
+    if (condition_diagrams) { condition_diagrams->add_unsafe_state(state); }
+    auto state_condition = state.to_condition(false, model);
+
+    // exclude condition
+    auto negated = state_condition->deepCopy_Exp();
+    TO_NORMALFORM::negate(negated);
+    start_condition.append(std::move(negated));
+
+    // include condition
+    unsafety_condition.append(std::move(state_condition));
+}
+
+void StrengtheningStrategy::exclude_box(
+    StartGenerator::JunctionCondition& start_condition,
+    StartGenerator::JunctionCondition& unsafety_condition,
+    std::unique_ptr<Expression> box,
+    const BoundedBox::Corners* corners,
+    const std::unordered_set<std::unique_ptr<StateBase>>& states) {
+    if (condition_diagrams) {
+        if (corners) {
+            condition_diagrams->add_unsafe_box(corners->first, corners->second);
+        } else {
+            condition_diagrams->add_unsafe_region(*box, states);
+        }
+    }
+    auto negated_box = box->deepCopy_Exp();
+    TO_NORMALFORM::negate(negated_box);
+    start_condition.append(std::move(negated_box));
+    unsafety_condition.append(std::move(box));
+}
+
 /**
  * @brief Removes unsafe states from the start condition and adds them to the unsafety condition.
  *
@@ -78,54 +172,15 @@ StartConditionStrengtheningStrategy::StartConditionStrengtheningStrategy(
  * Unsafety condition coarsened by disjuncting each unsafe state with it.
  *
  * @param unsafe_states set of states from which the policy reached the unsafety condition.
- *
- * @return Refined start_condition and coarsend unsafety condition.
  */
-std::pair<std::unique_ptr<Expression>, std::unique_ptr<Expression>> InvariantStrengtheningStrategy::update_conditions(
-    Expression& start_condition,
-    Expression& unsafety_condition,
+void InvariantStrengtheningStrategy::update_conditions(
+    StartGenerator::JunctionCondition& start_condition,
+    StartGenerator::JunctionCondition& unsafety_condition,
     const bool approximate,
-    std::unordered_set<std::unique_ptr<StateBase>>& unsafe_states) {
-
+    std::unordered_set<std::unique_ptr<StateBase>>& unsafe_states,
+    const StartGenerator::BoxAccumulator* unsafe_bounds) {
     PLAJA_LOG("Updating Conditions ...")
-
-    auto start_condition_copy = start_condition.deepCopy_Exp();
-    auto unsafety_condition_copy = unsafety_condition.deepCopy_Exp();
-
-    // split start and unsafety conditions
-    std::list<std::unique_ptr<Expression>> conjuncts =
-        TO_NORMALFORM::split_conjunction(std::move(start_condition_copy), false);
-    std::list<std::unique_ptr<Expression>> disjunctions =
-        TO_NORMALFORM::split_disjunction(std::move(unsafety_condition_copy), false);
-
-    if (approximate and approx != Approximation::Type::None) {
-        auto box = get_box_approximation(unsafe_states);
-        auto negated_box = box->deepCopy_Exp();
-        TO_NORMALFORM::negate(negated_box);
-        conjuncts.push_back(std::move(negated_box));
-        disjunctions.push_back(std::move(box));
-    } else {
-        for (const auto& state: unsafe_states) {
-            auto state_condition = state->to_condition(false, model);
-
-            // exclude condition
-            auto negated = state_condition->deepCopy_Exp();
-            TO_NORMALFORM::negate(negated);
-            conjuncts.push_back(std::move(negated));
-
-            // include condition
-            disjunctions.push_back(std::move(state_condition));
-        }
-    }
-
-    auto new_start = TO_NORMALFORM::construct_conjunction(std::move(conjuncts));
-    TO_NORMALFORM::normalize(new_start);
-    TO_NORMALFORM::specialize(new_start);
-    auto new_unsafety = TO_NORMALFORM::construct_disjunction(std::move(disjunctions));
-    TO_NORMALFORM::normalize(new_unsafety);
-    TO_NORMALFORM::specialize(new_unsafety);
-
-    return std::make_pair(std::move(new_start), std::move(new_unsafety));
+    exclude_states(start_condition, unsafety_condition, approximate, unsafe_states, unsafe_bounds);
 }
 
 /**
@@ -134,33 +189,22 @@ std::pair<std::unique_ptr<Expression>, std::unique_ptr<Expression>> InvariantStr
  * Removes unsafe *start* states from start condition by conjunction of negated unsafe states.
  *
  * @param start_condition updated according to unsafe states.
- * @param unsafety_condition remains unchanged.
+ * @param unsafety_condition extended by the unsafe start states.
  * @param unsafe_states set of states from which the policy reached the unsafety condition.
- *
- * @return new start condition along with the unchanged unsafety condition.
  */
-std::pair<std::unique_ptr<Expression>, std::unique_ptr<Expression>> StartConditionStrengtheningStrategy::
-    update_conditions(
-        Expression& start_condition,
-        Expression& unsafety_condition,
-        const bool approximate,
-        std::unordered_set<std::unique_ptr<StateBase>>& unsafe_states) {
+void StartConditionStrengtheningStrategy::update_conditions(
+    StartGenerator::JunctionCondition& start_condition,
+    StartGenerator::JunctionCondition& unsafety_condition,
+    const bool approximate,
+    std::unordered_set<std::unique_ptr<StateBase>>& unsafe_states,
+    const StartGenerator::BoxAccumulator* unsafe_bounds) {
 
     PLAJA_LOG("Updating Conditions ...")
 
-    auto start_condition_copy = start_condition.deepCopy_Exp();
-    auto unsafety_condition_copy = unsafety_condition.deepCopy_Exp();
-
-    // split start and unsafety conditions
-    std::list<std::unique_ptr<Expression>> conjuncts =
-        TO_NORMALFORM::split_conjunction(std::move(start_condition_copy), false);
-    std::list<std::unique_ptr<Expression>> disjunctions =
-        TO_NORMALFORM::split_disjunction(std::move(unsafety_condition_copy), false);
-
     // filter start states.
     std::unordered_set<std::unique_ptr<StateBase>> unsafe_start_states;
     for (auto it = unsafe_states.begin(); it != unsafe_states.end();) {
-        if (start_condition.evaluate_integer(**it)) {
+        if (start_condition.get().evaluate_integer(**it)) {
             auto node = unsafe_states.extract(it++);
             unsafe_start_states.insert(std::move(node.value()));
         } else {
@@ -172,29 +216,7 @@ std::pair<std::unique_ptr<Expression>, std::unique_ptr<Expression>> StartConditi
         per_iter_stats->inc_unsigned(PLAJA::StatsUnsigned::UNSAFE_STATES, unsafe_start_states.size());
     }
 
-    if (approximate and approx != Approximation::Type::None) {
-        auto box = get_box_approximation(unsafe_start_states);
-        auto negated_box = box->deepCopy_Exp();
-        TO_NORMALFORM::negate(negated_box);
-        conjuncts.push_back(std::move(negated_box));
-        disjunctions.push_back(std::move(box));
-    } else {
-        for (const auto& state: unsafe_start_states) {
-            auto state_condition = state->to_condition(false, model);
-            auto negated_state = state_condition->deepCopy_Exp();
-            // exclude condition
-            TO_NORMALFORM::negate(negated_state);
-            conjuncts.push_back(std::move(negated_state));
-            disjunctions.push_back(std::move(state_condition));
-        }
-    }
-
-    // construct new start condition from conjuncts
-    auto new_start = TO_NORMALFORM::construct_conjunction(std::move(conjuncts));
-    TO_NORMALFORM::normalize(new_start);
-    TO_NORMALFORM::specialize(new_start);
-    auto new_unsafety = TO_NORMALFORM::construct_disjunction(std::move(disjunctions));
-    TO_NORMALFORM::normalize(new_unsafety);
-    TO_NORMALFORM::specialize(new_unsafety);
-    return std::make_pair(std::move(new_start), std::move(new_unsafety));
-}
\ No newline at end of file
+    // the bounds are of the start states only if no state was filtered out.
+    const auto* start_bounds = unsafe_states.empty() ? unsafe_bounds : nullptr;
+    exclude_states(start_condition, unsafety_condition, approximate, unsafe_start_states, start_bounds);
+}
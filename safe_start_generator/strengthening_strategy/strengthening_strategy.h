@@ -8,11 +8,18 @@
 #include "../../states/forward_states.h"
 #include "../../using_search.h"
 #include "../approximation_methods/approximation_type.h"
+#include "../approximation_methods/bounded_box.h"
 
 #include <memory>
 #include <unordered_set>
+#include <vector>
 
 class StartGenerationStatistics;
+namespace StartGenerator {
+    class BoxAccumulator;
+    class ConditionDiagrams;
+    class JunctionCondition;
+}
 namespace VerificationMethods {
     enum class Type;
 }
@@ -23,11 +30,16 @@ class StrengtheningStrategy {
 public:
     virtual ~StrengtheningStrategy() = default;
 
-    virtual std::pair<std::unique_ptr<Expression>, std::unique_ptr<Expression>> update_conditions(
-        Expression& start_condition,
-        Expression& unsafety_condition,
+    /**
+     * @brief refines both conditions in place, see `JunctionCondition`.
+     * @param unsafe_bounds bounds accumulated while exactly the unsafe states were collected, nullptr if there are none.
+     */
+    virtual void update_conditions(
+        StartGenerator::JunctionCondition& start_condition,
+        StartGenerator::JunctionCondition& unsafety_condition,
         bool approximate,
-        std::unordered_set<std::unique_ptr<StateBase>>& unsafe_states) = 0;
+        std::unordered_set<std::unique_ptr<StateBase>>& unsafe_states,
+        const StartGenerator::BoxAccumulator* unsafe_bounds) = 0;
 
     // Factory method to create appropriate strategy
     static std::unique_ptr<StrengtheningStrategy> create(
@@ -36,6 +48,18 @@ public:
         Approximation::Type approximation_type,
         StartGenerationStatistics* per_iter_stats);
 
+    /// diagrams (optional) are refined alongside the expression conditions.
+    void set_condition_diagrams(StartGenerator::ConditionDiagrams* diagrams) { condition_diagrams = diagrams; }
+
+    /// valuations (excluding loc) observed to be safe, used to train the decision tree approximation.
+    void set_safe_samples(std::vector<std::vector<int>> samples) { safe_samples = std::move(samples); }
+
+    /// limits of the multi-box underapproximation: maximal number of boxes and targeted coverage of the unsafe set.
+    void set_multi_box_limits(const std::size_t boxes, const double coverage) {
+        max_boxes = boxes;
+        box_coverage = coverage;
+    }
+
 protected:
     explicit StrengtheningStrategy(
         const Model& model,
@@ -44,8 +68,40 @@ protected:
     const Model& model;
     const Approximation::Type approx;
     StartGenerationStatistics* per_iter_stats;
+    StartGenerator::ConditionDiagrams* condition_diagrams = nullptr;
+    std::size_t max_boxes = 8;
+    double box_coverage = 1;
+    std::vector<std::vector<int>> safe_samples;
+
+    /**
+     * @param bounds of exactly the set (optional), the bounding box is then built from them instead of the set.
+     * @param corners set to the corners of a box approximation, left empty for polyhedra.
+     */
+    std::unique_ptr<Expression> get_box_approximation(
+        const std::unordered_set<std::unique_ptr<StateBase>>& set,
+        const StartGenerator::BoxAccumulator* bounds,
+        BoundedBox::Corners& corners);
+
+    /// excludes the states (or their box approximation) from the start and includes them in the unsafety condition.
+    void exclude_states(
+        StartGenerator::JunctionCondition& start_condition,
+        StartGenerator::JunctionCondition& unsafety_condition,
+        bool approximate,
+        const std::unordered_set<std::unique_ptr<StateBase>>& states,
+        const StartGenerator::BoxAccumulator* bounds);
 
-    std::unique_ptr<Expression> get_box_approximation(const std::unordered_set<std::unique_ptr<StateBase>>& set);
+private:
+    void exclude_state(
+        StartGenerator::JunctionCondition& start_condition,
+        StartGenerator::JunctionCondition& unsafety_condition,
+        const StateBase& state);
+    /// @param corners of the box, nullptr if it is a polyhedron, which the diagrams then enumerate around the states.
+    void exclude_box(
+        StartGenerator::JunctionCondition& start_condition,
+        StartGenerator::JunctionCondition& unsafety_condition,
+        std::unique_ptr<Expression> box,
+        const BoundedBox::Corners* corners,
+        const std::unordered_set<std::unique_ptr<StateBase>>& states);
 };
 
 class InvariantStrengtheningStrategy: public StrengtheningStrategy {
@@ -55,11 +111,12 @@ public:
         Approximation::Type approximation_type,
         StartGenerationStatistics* per_iter_stats);
 
-    std::pair<std::unique_ptr<Expression>, std::unique_ptr<Expression>> update_conditions(
-        Expression& start_condition,
-        Expression& unsafety_condition,
+    void update_conditions(
+        StartGenerator::JunctionCondition& start_condition,
+        StartGenerator::JunctionCondition& unsafety_condition,
         bool approximate,
-        std::unordered_set<std::unique_ptr<StateBase>>& unsafe_states) override;
+        std::unordered_set<std::unique_ptr<StateBase>>& unsafe_states,
+        const StartGenerator::BoxAccumulator* unsafe_bounds) override;
 };
 
 class StartConditionStrengtheningStrategy: public StrengtheningStrategy {
@@ -69,11 +126,12 @@ public:
         Approximation::Type approximation_type,
         StartGenerationStatistics* per_iter_stats);
 
-    std::pair<std::unique_ptr<Expression>, std::unique_ptr<Expression>> update_conditions(
-        Expression& start_condition,
-        Expression& unsafety_condition,
+    void update_conditions(
+        StartGenerator::JunctionCondition& start_condition,
+        StartGenerator::JunctionCondition& unsafety_condition,
         bool approximate,
-        std::unordered_set<std::unique_ptr<StateBase>>& unsafe_states) override;
+        std::unordered_set<std::unique_ptr<StateBase>>& unsafe_states,
+        const StartGenerator::BoxAccumulator* unsafe_bounds) override;
 };
 
 #endif //STRENGTHENING_STRATEGY_H
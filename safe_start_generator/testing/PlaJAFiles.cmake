@@ -4,4 +4,28 @@ set(TESTING_SOURCES
         ${CMAKE_CURRENT_LIST_DIR}/policy_run_sampling.cpp
         ${CMAKE_CURRENT_LIST_DIR}/policy_run_sampling.h
         ${CMAKE_CURRENT_LIST_DIR}/transition_set.h
+        ${CMAKE_CURRENT_LIST_DIR}/rng_stream.h
+        ${CMAKE_CURRENT_LIST_DIR}/successor_cache.cpp
+        ${CMAKE_CURRENT_LIST_DIR}/successor_cache.h
+        ${CMAKE_CURRENT_LIST_DIR}/policy_cache.h
+        ${CMAKE_CURRENT_LIST_DIR}/policy_envelope.cpp
+        ${CMAKE_CURRENT_LIST_DIR}/policy_envelope.h
+        ${CMAKE_CURRENT_LIST_DIR}/envelope_explorer.cpp
+        ${CMAKE_CURRENT_LIST_DIR}/envelope_explorer.h
+        ${CMAKE_CURRENT_LIST_DIR}/concurrent_state_registry.cpp
+        ${CMAKE_CURRENT_LIST_DIR}/concurrent_state_registry.h
+        ${CMAKE_CURRENT_LIST_DIR}/splitting_search.cpp
+        ${CMAKE_CURRENT_LIST_DIR}/splitting_search.h
+        ${CMAKE_CURRENT_LIST_DIR}/start_coverage.cpp
+        ${CMAKE_CURRENT_LIST_DIR}/start_coverage.h
+        ${CMAKE_CURRENT_LIST_DIR}/start_validation.cpp
+        ${CMAKE_CURRENT_LIST_DIR}/start_validation.h
+        ${CMAKE_CURRENT_LIST_DIR}/start_sampler.cpp
+        ${CMAKE_CURRENT_LIST_DIR}/start_sampler.h
+        ${CMAKE_CURRENT_LIST_DIR}/testing_mode.h
+        ${CMAKE_CURRENT_LIST_DIR}/trajectory_log.cpp
+        ${CMAKE_CURRENT_LIST_DIR}/trajectory_log.h
+        ${CMAKE_CURRENT_LIST_DIR}/trajectory_log_format.h
+        ${CMAKE_CURRENT_LIST_DIR}/trajectory_log_reader.cpp
+        ${CMAKE_CURRENT_LIST_DIR}/trajectory_log_reader.h
 )
\ No newline at end of file
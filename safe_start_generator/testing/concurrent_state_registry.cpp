@@ -0,0 +1,69 @@
+//
+// Created by Daniel Sherbakov in 2025.
+//
+
+#include "concurrent_state_registry.h"
+
+#include "../../../assertions.h"
+
+#include <algorithm>
+#include <mutex>
+
+namespace StartGenerator {
+
+    ConcurrentStateRegistry::ConcurrentStateRegistry(const std::size_t num_shards):
+        shards(std::max<std::size_t>(1, num_shards)),
+        segments(std::make_unique<std::atomic<Segment*>[]>(max_segments)) {
+        for (std::size_t i = 0; i < max_segments; ++i) { segments[i].store(nullptr, std::memory_order_relaxed); }
+    }
+
+    ConcurrentStateRegistry::~ConcurrentStateRegistry() {
+        for (std::size_t i = 0; i < max_segments; ++i) { delete segments[i].load(std::memory_order_relaxed); }
+    }
+
+    std::pair<ConcurrentStateRegistry::ID, bool> ConcurrentStateRegistry::insert(const Valuation& valuation) {
+        auto& shard = shards[shard_index(valuation)];
+        {
+            std::shared_lock<std::shared_mutex> lock(shard.mutex);
+            const auto it = shard.ids.find(valuation);
+            if (it != shard.ids.end()) { return { it->second, false }; }
+        }
+
+        std::unique_lock<std::shared_mutex> lock(shard.mutex);
+        // another thread may have registered the valuation in between.
+        const auto [it, inserted] = shard.ids.try_emplace(valuation, 0);
+        if (not inserted) { return { it->second, false }; }
+        const ID id = num_states.fetch_add(1, std::memory_order_relaxed);
+        PLAJA_ASSERT(id / segment_size < max_segments)
+        it->second = id;
+        publish(id, &it->first);
+        return { id, true };
+    }
+
+    const Valuation& ConcurrentStateRegistry::get(const ID id) const {
+        const auto* segment = segments[id >> segment_bits].load(std::memory_order_acquire);
+        PLAJA_ASSERT(segment)
+        const auto* valuation = (*segment)[id & (segment_size - 1)].load(std::memory_order_acquire);
+        PLAJA_ASSERT(valuation)
+        return *valuation;
+    }
+
+    std::size_t ConcurrentStateRegistry::shard_index(const Valuation& valuation) const {
+        return ValuationHash()(valuation) % shards.size();
+    }
+
+    /// the segment of an ID is allocated by the first thread that registers a state in it.
+    void ConcurrentStateRegistry::publish(const ID id, const Valuation* valuation) {
+        auto& slot = segments[id >> segment_bits];
+        auto* segment = slot.load(std::memory_order_acquire);
+        if (not segment) {
+            auto fresh = std::make_unique<Segment>();
+            for (auto& entry: *fresh) { entry.store(nullptr, std::memory_order_relaxed); }
+            if (slot.compare_exchange_strong(segment, fresh.get(), std::memory_order_acq_rel)) {
+                segment = fresh.release();
+            } // otherwise, segment holds the one of the other thread.
+        }
+        (*segment)[id & (segment_size - 1)].store(valuation, std::memory_order_release);
+    }
+
+} // namespace StartGenerator
@@ -0,0 +1,69 @@
+//
+// Created by Daniel Sherbakov in 2025.
+//
+
+#ifndef CONCURRENT_STATE_REGISTRY_H
+#define CONCURRENT_STATE_REGISTRY_H
+
+#include "../../../utils/default_constructors.h"
+#include "../state_valuation.h"
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <shared_mutex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace StartGenerator {
+
+    /**
+     * @brief State registry that can be shared by many threads.
+     *
+     * Interns valuations and hands out dense, stable IDs, i.e., an ID never changes and is never reused.
+     * The valuations are partitioned into shards by hash, each guarded by a reader-writer lock, so threads only contend
+     * on inserts into the same shard, and lookups of registered states (the common case in a converging exploration)
+     * only take the lock in shared mode.
+     * The valuation of an ID is read without locking through a segmented table, whose segments are never moved.
+     */
+    class ConcurrentStateRegistry {
+    public:
+        using ID = uint32_t;
+
+        explicit ConcurrentStateRegistry(std::size_t num_shards);
+        ~ConcurrentStateRegistry();
+        DELETE_CONSTRUCTOR(ConcurrentStateRegistry)
+
+        /// @return ID of valuation and whether it was registered by this call.
+        std::pair<ID, bool> insert(const Valuation& valuation);
+
+        /// @return valuation of an ID handed out by `insert`; valid as long as the registry.
+        [[nodiscard]] const Valuation& get(ID id) const;
+
+        /// @return number of registered states.
+        [[nodiscard]] std::size_t size() const { return num_states.load(std::memory_order_relaxed); }
+
+    private:
+        static constexpr std::size_t segment_bits = 16;
+        static constexpr std::size_t segment_size = std::size_t { 1 } << segment_bits;
+        static constexpr std::size_t max_segments = (std::size_t { 1 } << 32) / segment_size;
+
+        struct Shard {
+            mutable std::shared_mutex mutex;
+            std::unordered_map<Valuation, ID, ValuationHash> ids; // keys do not move on rehash.
+        };
+        using Segment = std::array<std::atomic<const Valuation*>, segment_size>;
+
+        std::vector<Shard> shards;
+        std::atomic<ID> num_states { 0 };
+        std::unique_ptr<std::atomic<Segment*>[]> segments;
+
+        [[nodiscard]] std::size_t shard_index(const Valuation& valuation) const;
+        void publish(ID id, const Valuation* valuation);
+    };
+
+} // namespace StartGenerator
+
+#endif //CONCURRENT_STATE_REGISTRY_H
@@ -0,0 +1,230 @@
+//
+// Created by Daniel Sherbakov in 2025.
+//
+
+#include "envelope_explorer.h"
+
+#include "../../../parser/ast/expression/expression.h"
+#include "../../../parser/ast/model.h"
+#include "../../fd_adaptions/state.h"
+#include "../../information/model_information.h"
+#include "../../non_prob_search/policy/policy.h"
+#include "../../stats/stats_base.h"
+#include "../../successor_generation/simulation_environment.h"
+#include "../start_generation_statistics.h"
+#include "policy_envelope.h"
+
+#include <iostream>
+#include <memory>
+#include <thread>
+#include <utility>
+
+namespace {
+    constexpr std::size_t shards_per_thread = 16;
+    /// valuations enumerated per start state limit, so that a sparse start condition cannot stall the enumeration.
+    constexpr std::size_t valuations_per_start_state = 64;
+    /// valuations enumerated between checks of the deadline.
+    constexpr std::size_t deadline_poll_interval = std::size_t { 1 } << 12;
+}
+
+EnvelopeExplorer::EnvelopeExplorer(
+    const PLAJA::Configuration& config,
+    const Model& model,
+    const Policy& policy,
+    StartGenerator::PolicyLoader load_policy,
+    const Expression& start_condition,
+    const Expression& unsafety_condition,
+    PLAJA::StatsBase& search_statistics,
+    StartGenerationStatistics* per_iter_stats,
+    const unsigned num_threads,
+    const std::size_t max_states,
+    const StartGenerator::Deadline& deadline):
+    config(config),
+    model(model),
+    policy(policy),
+    load_policy(std::move(load_policy)),
+    start_condition(start_condition),
+    unsafety_condition(unsafety_condition),
+    search_stats(search_statistics),
+    per_iter_stats(per_iter_stats),
+    num_threads(std::max(1u, num_threads)),
+    max_states(max_states),
+    deadline(deadline),
+    registry(this->num_threads * shards_per_thread),
+    queues(this->num_threads) {}
+
+EnvelopeExplorer::~EnvelopeExplorer() = default;
+
+/**
+ * Explores the envelope from all start states in parallel and propagates unsafety backwards.
+ *
+ * @return start states from which the unsafety condition is reachable.
+ */
+std::unordered_set<std::unique_ptr<StateBase>> EnvelopeExplorer::explore() {
+    const auto start_states = enumerate_start_states();
+    search_stats.inc_attr_unsigned(PLAJA::StatsUnsigned::START_STATES, start_states.size());
+
+    std::vector<Node> start_nodes;
+    start_nodes.reserve(start_states.size());
+    for (std::size_t i = 0; i < start_states.size(); ++i) {
+        const auto node = insert(start_states[i]).first;
+        start_nodes.push_back(node);
+        ++open_nodes;
+        queues[i % num_threads].queue.push_back(node);
+    }
+
+    // loaded up front on this thread, loading is not thread-safe either.
+    while (worker_policies.size() + 1 < num_threads) { worker_policies.push_back(load_policy()); }
+    std::vector<const Policy*> policies { &policy };
+    for (const auto& worker_policy: worker_policies) { policies.push_back(worker_policy.get()); }
+
+    std::vector<WorkerResult> results(num_threads);
+    std::vector<std::thread> workers;
+    workers.reserve(num_threads);
+    for (unsigned worker = 0; worker < num_threads; ++worker) {
+        workers.emplace_back(
+            &EnvelopeExplorer::run_worker,
+            this,
+            worker,
+            std::cref(*policies[worker]),
+            std::ref(results[worker]));
+    }
+    for (auto& worker: workers) { worker.join(); }
+
+    // propagate unsafety through the explored envelope.
+    StartGenerator::PolicyEnvelope envelope;
+    std::size_t dead_ends = 0;
+    for (const auto& result: results) {
+        for (const auto& [source, target]: result.transitions) { envelope.add_transition(source, target); }
+        for (const auto node: result.unsafe_nodes) { envelope.mark_unsafe(node); }
+        dead_ends += result.dead_ends;
+    }
+    search_stats.inc_attr_unsigned(PLAJA::StatsUnsigned::DEAD_ENDS, dead_ends);
+    std::unordered_set<StateID_type> unsafe_nodes;
+    for (const auto& result: results) { unsafe_nodes.insert(result.unsafe_nodes.begin(), result.unsafe_nodes.end()); }
+    const auto propagated = envelope.propagate_unsafety();
+    unsafe_nodes.insert(propagated.begin(), propagated.end());
+
+    std::unordered_set<std::unique_ptr<StateBase>> unsafe_start_states;
+    const auto& model_info = model.get_model_information();
+    for (std::size_t i = 0; i < start_nodes.size(); ++i) {
+        if (not unsafe_nodes.count(start_nodes[i])) { continue; }
+        unsafe_start_states.emplace(StartGenerator::to_state_values(start_states[i], model_info).to_ptr());
+    }
+
+    std::cout << "Explored " << registry.size() << " states with " << num_threads << " threads, "
+              << unsafe_start_states.size() << " of " << start_states.size() << " start states are unsafe." << '\n';
+    if (limit_reached) { PLAJA_LOG("... State or time limit reached: result is not exact.") }
+    if (limit_reached and per_iter_stats) { per_iter_stats->inc_unsigned(PLAJA::StatsUnsigned::TIME_LIMIT_REACHED, 1); }
+    return unsafe_start_states;
+}
+
+std::pair<EnvelopeExplorer::Node, bool> EnvelopeExplorer::insert(const StartGenerator::Valuation& valuation) {
+    const auto rlt = registry.insert(valuation);
+    if (rlt.second and registry.size() >= max_states) { limit_reached = true; }
+    return rlt;
+}
+
+/// pops from the front of the own queue, or steals from the back of another queue.
+bool EnvelopeExplorer::pop(const unsigned worker, Node& node) {
+    {
+        auto& own = queues[worker];
+        std::lock_guard<std::mutex> lock(own.mutex);
+        if (not own.queue.empty()) {
+            node = own.queue.front();
+            own.queue.pop_front();
+            return true;
+        }
+    }
+    for (unsigned offset = 1; offset < num_threads; ++offset) {
+        auto& victim = queues[(worker + offset) % num_threads];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (not victim.queue.empty()) {
+            node = victim.queue.back();
+            victim.queue.pop_back();
+            return true;
+        }
+    }
+    return false;
+}
+
+void EnvelopeExplorer::run_worker(const unsigned worker, const Policy& worker_policy, WorkerResult& result) {
+    SimulationEnvironment sim_env(config, model); // stores the states it handles a second time, see class doc.
+    const auto& model_info = model.get_model_information();
+    Node node;
+
+    while (true) {
+        if (not pop(worker, node)) {
+            if (open_nodes == 0) { break; }
+            std::this_thread::yield();
+            continue;
+        }
+        const auto state = sim_env.get_state(StartGenerator::to_state_values(registry.get(node), model_info));
+
+        if (not limit_reached and deadline.is_expired()) { limit_reached = true; }
+        if (unsafety_condition.evaluate_integer(state)) {
+            result.unsafe_nodes.push_back(node); // unsafe states are not expanded.
+        } else if (not limit_reached) {
+            const auto applicable_actions = sim_env.extract_applicable_actions(state, true);
+            if (applicable_actions.empty()) {
+                ++result.dead_ends;
+            } else {
+                // as in policy execution, the policy is only queried at choice points.
+                ActionLabel_type action_label = applicable_actions[0];
+                if (applicable_actions.size() > 1) { action_label = worker_policy.evaluate(state); }
+                for (const auto successor_id: sim_env.compute_successors(state, action_label)) {
+                    const auto [successor_node, inserted] =
+                        insert(StartGenerator::to_valuation(sim_env.get_state(successor_id)));
+                    result.transitions.emplace_back(node, successor_node);
+                    if (inserted and not limit_reached) {
+                        ++open_nodes;
+                        auto& own = queues[worker];
+                        std::lock_guard<std::mutex> lock(own.mutex);
+                        own.queue.push_back(successor_node);
+                    }
+                }
+            }
+        }
+        --open_nodes;
+    }
+}
+
+/**
+ * Enumerates the variable domains, which stops early, with `limit_reached` set, after max_states start states, after a
+ * number of valuations proportional to max_states, or at the deadline.
+ *
+ * @return valuations of all states in the variable domains satisfying the start condition, unless stopped early.
+ */
+std::vector<StartGenerator::Valuation> EnvelopeExplorer::enumerate_start_states() {
+    const auto& model_info = model.get_model_information();
+    const auto num_vars = model.get_number_variables();
+    auto valuation = StartGenerator::to_valuation(model_info.get_initial_values());
+    for (int var = 1; var <= num_vars; ++var) { valuation[var] = model_info.get_lower_bound_int(var); }
+
+    const auto max_valuations = max_states > SIZE_MAX / valuations_per_start_state
+                                    ? SIZE_MAX
+                                    : max_states * valuations_per_start_state;
+    std::vector<StartGenerator::Valuation> start_states;
+    for (std::size_t num_valuations = 1;; ++num_valuations) {
+        if (num_valuations > max_valuations
+            or (num_valuations % deadline_poll_interval == 0 and deadline.is_expired())) {
+            limit_reached = true;
+            break;
+        }
+        if (start_condition.evaluate_integer(StartGenerator::to_state_values(valuation, model_info))) {
+            if (start_states.size() >= max_states) {
+                limit_reached = true; // truncated, unsafe start states may be missed.
+                break;
+            }
+            start_states.push_back(valuation);
+        }
+        // next valuation (odometer over the variable domains, location at index 0 is fixed).
+        int var = 1;
+        for (; var <= num_vars; ++var) {
+            if (++valuation[var] <= model_info.get_upper_bound_int(var)) { break; }
+            valuation[var] = model_info.get_lower_bound_int(var);
+        }
+        if (var > num_vars) { break; }
+    }
+    return start_states;
+}
@@ -0,0 +1,117 @@
+//
+// Created by Daniel Sherbakov in 2025.
+//
+
+#ifndef ENVELOPE_EXPLORER_H
+#define ENVELOPE_EXPLORER_H
+
+#include "../../../utils/default_constructors.h"
+#include "../../states/forward_states.h"
+#include "../../using_search.h"
+#include "../deadline.h"
+#include "../state_valuation.h"
+#include "policy_cache.h"
+#include "concurrent_state_registry.h"
+
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+namespace PLAJA {
+    class Configuration;
+    class StatsBase;
+}
+class Expression;
+class Model;
+class StartGenerationStatistics;
+
+/**
+ * @brief Exhaustive explicit-state exploration of the policy envelope.
+ *
+ * Alternative to `UnsafePathIdentifier` for models with small finite domains: enumerates all start states of the start
+ * condition and explores every state reachable under the policy in parallel breadth-first fashion.
+ * Afterwards, unsafety is propagated backwards through the explored envelope, which yields exactly the set of start
+ * states from which the policy can reach the unsafety condition.
+ *
+ * Workers own a simulation environment and a policy instance each, and share
+ * - a concurrent state registry that maps valuations to global node indices, and
+ * - per-worker deques of node indices as frontier; idle workers steal from the other end of a different worker's deque.
+ *
+ * Known limitation: the concurrent registry is only the visited set of this explorer. Successors are still computed by
+ * a `SimulationEnvironment`, whose state registry is not thread-safe, so each worker keeps its own environment and
+ * every state it expands or generates is stored there as well. Memory is therefore about twice the size of the
+ * explored envelope. The other testing components use the generator's simulation environment only.
+ */
+class EnvelopeExplorer {
+public:
+    EnvelopeExplorer(
+        const PLAJA::Configuration& config,
+        const Model& model,
+        const Policy& policy,
+        StartGenerator::PolicyLoader load_policy,
+        const Expression& start_condition,
+        const Expression& unsafety_condition,
+        PLAJA::StatsBase& search_statistics,
+        StartGenerationStatistics* per_iter_stats,
+        unsigned num_threads,
+        std::size_t max_states,
+        const StartGenerator::Deadline& deadline);
+    ~EnvelopeExplorer();
+    DELETE_CONSTRUCTOR(EnvelopeExplorer)
+
+    /// @return all start states that can reach the unsafety condition under the policy.
+    std::unordered_set<std::unique_ptr<StateBase>> explore();
+
+    /// @return false if exploration stopped at the state limit or deadline, i.e., the result is not exact.
+    [[nodiscard]] bool is_complete() const { return not limit_reached; }
+
+private:
+    using Node = StartGenerator::ConcurrentStateRegistry::ID;
+
+    const PLAJA::Configuration& config;
+    const Model& model;
+    const Policy& policy; // of the first worker.
+    const StartGenerator::PolicyLoader load_policy;
+    std::vector<std::unique_ptr<Policy>> worker_policies; // of the other workers, loaded once.
+    const Expression& start_condition;
+    const Expression& unsafety_condition;
+    PLAJA::StatsBase& search_stats;
+    StartGenerationStatistics* per_iter_stats;
+    const unsigned num_threads;
+    const std::size_t max_states;
+    const StartGenerator::Deadline deadline;
+
+    /* Visited set */
+    StartGenerator::ConcurrentStateRegistry registry;
+    std::atomic<bool> limit_reached { false };
+
+    /// @return node index of valuation and whether it was inserted by this call.
+    std::pair<Node, bool> insert(const StartGenerator::Valuation& valuation);
+
+    /* Frontier */
+    struct WorkQueue {
+        std::mutex mutex;
+        std::deque<Node> queue;
+    };
+    std::vector<WorkQueue> queues;
+    std::atomic<std::size_t> open_nodes { 0 }; // pushed but not yet expanded.
+
+    bool pop(unsigned worker, Node& node);
+
+    /* Per-worker results */
+    struct WorkerResult {
+        std::vector<std::pair<Node, Node>> transitions;
+        std::vector<Node> unsafe_nodes;
+        std::size_t dead_ends = 0;
+    };
+
+    void run_worker(unsigned worker, const Policy& worker_policy, WorkerResult& result);
+    std::vector<StartGenerator::Valuation> enumerate_start_states();
+};
+
+#endif //ENVELOPE_EXPLORER_H
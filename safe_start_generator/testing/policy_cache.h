@@ -0,0 +1,78 @@
+//
+// Created by Daniel Sherbakov in 2025.
+//
+
+#ifndef POLICY_CACHE_H
+#define POLICY_CACHE_H
+
+#include "../../fd_adaptions/state.h"
+#include "../../non_prob_search/policy/policy.h"
+#include "../../using_search.h"
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace StartGenerator {
+
+    /// creates a policy instance per call, owned by the caller, as policy evaluation is not thread-safe.
+    using PolicyLoader = std::function<std::unique_ptr<Policy>()>;
+
+    /**
+     * @brief Fixed-size direct-mapped cache of policy decisions keyed by state ID.
+     *
+     * The policy does not change during a run, hence a decision stays valid as long as the state ID does, i.e., for the
+     * lifetime of the state registry. A state hashing to an occupied slot overwrites the previous decision.
+     */
+    class PolicyCache {
+    public:
+        static constexpr std::size_t default_capacity = 1 << 18;
+
+        explicit PolicyCache(const Policy& policy, std::size_t capacity = default_capacity):
+            policy(policy) {
+            std::size_t size = 1;
+            while (size < capacity) { size <<= 1; }
+            table.resize(size, { -1, 0 });
+            mask = size - 1;
+        }
+
+        /// @return the policy decision for the state, evaluating the policy on a miss.
+        ActionLabel_type evaluate(const State& state) {
+            const auto id = state.get_id();
+            auto& slot = table[(static_cast<std::size_t>(id) * 0x9E3779B97F4A7C15ULL >> 16) & mask];
+            if (slot.id == id) {
+                ++hits;
+                return slot.action;
+            }
+            ++misses;
+            slot.id = id;
+            slot.action = policy.evaluate(state);
+            return slot.action;
+        }
+
+        [[nodiscard]] const Policy& get_policy() const { return policy; }
+        [[nodiscard]] std::size_t get_hits() const { return hits; }
+        [[nodiscard]] std::size_t get_misses() const { return misses; }
+        [[nodiscard]] double hit_rate() const {
+            return hits + misses == 0 ? 0 : static_cast<double>(hits) / static_cast<double>(hits + misses);
+        }
+        void reset_counters() { hits = misses = 0; }
+
+    private:
+        struct Slot {
+            StateID_type id;
+            ActionLabel_type action;
+        };
+
+        const Policy& policy;
+        std::vector<Slot> table;
+        std::size_t mask = 0;
+
+        std::size_t hits = 0;
+        std::size_t misses = 0;
+    };
+
+} // namespace StartGenerator
+
+#endif //POLICY_CACHE_H
@@ -0,0 +1,80 @@
+//
+// Created by Daniel Sherbakov in 2025.
+//
+
+#include "policy_envelope.h"
+
+#include <algorithm>
+
+namespace StartGenerator {
+
+    PolicyEnvelope::Node PolicyEnvelope::get_node(const StateID_type id) {
+        const auto [it, inserted] = node_index.emplace(id, static_cast<Node>(node_ids.size()));
+        if (inserted) {
+            node_ids.push_back(id);
+            unsafe.push_back(false);
+            labeled.push_back(false);
+        }
+        return it->second;
+    }
+
+    void PolicyEnvelope::add_transition(const StateID_type source, const StateID_type target) {
+        const auto source_node = get_node(source);
+        const auto target_node = get_node(target);
+        pending.emplace_back(target_node, source_node);
+    }
+
+    void PolicyEnvelope::mark_unsafe(const StateID_type id) { unsafe[get_node(id)] = true; }
+
+    /// rebuilds the CSR arrays including the pending transitions (counting sort by target).
+    void PolicyEnvelope::merge_pending() {
+        const std::size_t n = node_ids.size();
+        std::vector<uint32_t> degree(n + 1, 0);
+        for (Node v = 0; v + 1 < offsets.size(); ++v) { degree[v + 1] = offsets[v + 1] - offsets[v]; }
+        for (const auto& [target, source]: pending) { ++degree[target + 1]; }
+
+        std::vector<uint32_t> new_offsets(n + 1, 0);
+        for (std::size_t v = 0; v < n; ++v) { new_offsets[v + 1] = new_offsets[v] + degree[v + 1]; }
+
+        std::vector<Node> new_predecessors(new_offsets[n]);
+        std::vector<uint32_t> fill(new_offsets.begin(), new_offsets.end() - 1);
+        for (Node v = 0; v + 1 < offsets.size(); ++v) {
+            for (auto i = offsets[v]; i < offsets[v + 1]; ++i) { new_predecessors[fill[v]++] = predecessors[i]; }
+        }
+        for (const auto& [target, source]: pending) { new_predecessors[fill[target]++] = source; }
+
+        offsets = std::move(new_offsets);
+        predecessors = std::move(new_predecessors);
+        pending.clear();
+    }
+
+    std::vector<StateID_type> PolicyEnvelope::propagate_unsafety() {
+        if (not pending.empty()) { merge_pending(); }
+
+        std::vector<bool> reached(node_ids.size(), false);
+        std::vector<Node> queue;
+        for (Node v = 0; v < node_ids.size(); ++v) {
+            if (unsafe[v]) {
+                reached[v] = true;
+                queue.push_back(v);
+            }
+        }
+
+        std::vector<StateID_type> newly_labeled;
+        for (std::size_t head = 0; head < queue.size(); ++head) {
+            const Node v = queue[head];
+            for (auto i = offsets[v]; i < offsets[v + 1]; ++i) {
+                const Node u = predecessors[i];
+                if (reached[u]) { continue; }
+                reached[u] = true;
+                queue.push_back(u);
+                if (not labeled[u]) {
+                    labeled[u] = true;
+                    newly_labeled.push_back(node_ids[u]);
+                }
+            }
+        }
+        return newly_labeled;
+    }
+
+} // namespace StartGenerator
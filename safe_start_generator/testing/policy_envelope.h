@@ -0,0 +1,64 @@
+//
+// Created by Daniel Sherbakov in 2025.
+//
+
+#ifndef POLICY_ENVELOPE_H
+#define POLICY_ENVELOPE_H
+
+#include "../../using_search.h"
+
+#include <cstdint>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace StartGenerator {
+
+    /**
+     * @brief Explored part of the policy envelope.
+     *
+     * Collects the policy induced transitions observed during testing and the states known to be unsafe.
+     * Transitions are kept as reverse adjacency in compressed sparse row (CSR) form; transitions added since the last
+     * propagation are buffered and merged into the CSR arrays on the next propagation.
+     *
+     * Since neither the policy nor the transition relation change during a run, the graph is kept across testing
+     * phases, so trajectories of earlier phases also take part in the propagation.
+     */
+    class PolicyEnvelope {
+    public:
+        PolicyEnvelope() = default;
+
+        void add_transition(StateID_type source, StateID_type target);
+        void mark_unsafe(StateID_type id);
+
+        /**
+         * @brief Backward BFS from all known unsafe states.
+         *
+         * @return explored states that can reach a known unsafe state and were not returned by an earlier call,
+         * excluding the unsafe states themselves.
+         */
+        std::vector<StateID_type> propagate_unsafety();
+
+        [[nodiscard]] std::size_t num_states() const { return node_ids.size(); }
+        [[nodiscard]] std::size_t num_transitions() const { return predecessors.size() + pending.size(); }
+
+    private:
+        using Node = uint32_t;
+
+        std::unordered_map<StateID_type, Node> node_index;
+        std::vector<StateID_type> node_ids;
+        std::vector<bool> unsafe;
+        std::vector<bool> labeled; // reported as unsafe by an earlier propagation.
+
+        // reverse CSR: predecessors of node v are predecessors[offsets[v] .. offsets[v + 1]).
+        std::vector<uint32_t> offsets { 0 };
+        std::vector<Node> predecessors;
+        std::vector<std::pair<Node, Node>> pending; // (target, source) not yet merged.
+
+        Node get_node(StateID_type id);
+        void merge_pending();
+    };
+
+} // namespace StartGenerator
+
+#endif //POLICY_ENVELOPE_H
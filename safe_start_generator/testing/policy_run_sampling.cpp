@@ -5,7 +5,6 @@
 #include "policy_run_sampling.h"
 
 #include "../../fd_adaptions/state.h"
-#include "../../fd_adaptions/timer.h"
 #include "../../non_prob_search/policy/policy.h"
 #include "../../parser/ast/expression/expression.h"
 #include "../../smt/bias_functions/distance_function.h"
@@ -16,9 +15,10 @@
 #include <numeric>
 #include <utility>
 PolicyRunSampler::PolicyRunSampler(
-    Timer& timer,
+    const StartGenerator::Deadline& deadline,
     const SimulationEnvironment& simulationEnv,
-    const Policy& policy,
+    StartGenerator::SuccessorCache& successor_cache,
+    StartGenerator::PolicyCache& policy,
     const Expression& start_condition,
     const Expression& unsafety_condition,
     const ModelZ3& model_z3,
@@ -29,8 +29,9 @@ PolicyRunSampler::PolicyRunSampler(
     start_condition(start_condition),
     unsafety_condition(unsafety_condition),
     simEnv(simulationEnv),
+    successor_cache(successor_cache),
     policy(policy),
-    timer(timer),
+    deadline(deadline),
     use_probabilistic_sampling(probabilistic_sampling),
     max_policy_run_length(max_run_length),
     search_stats(search_statistics),
@@ -51,27 +52,30 @@ PolicyRunSampler::~PolicyRunSampler() = default;
 * reached. The leaf state is sampled from the probability distribution based on the distance of the leaves, or greedily
 * depending on the flag `use_probabilistic_sampling` .
 *
-* @return leaf state sampled from probability distribution based on the distance of the leaves.
+* @return ID of the leaf state sampled from probability distribution based on the distance of the leaves, along with
+* the path leading to it.
 */
-std::pair<std::unique_ptr<State>, std::vector<StateID_type>> PolicyRunSampler::sample_run(
-    const std::vector<StateID_type>& successor_ids) {
+std::pair<StateID_type, std::vector<StateID_type>> PolicyRunSampler::sample_run(
+    const std::vector<StateID_type>& successor_ids,
+    StartGenerator::RngStream& rng) {
     std::unordered_map<StateID_type, int> successors_to_distance;
-    std::unordered_set<StateID_type> current_successors; // frontier
-    std::unordered_map<StateID_type, std::unique_ptr<SearchNode>> search_tree;
+    current_successors.clear();
+    search_tree.clear();
+    search_tree_index.clear();
 
     for (StateID_type s: successor_ids) {
         current_successors.insert(s);
-        search_tree[s] = std::make_unique<SearchNode>(s, nullptr);
+        search_tree_index[s] = search_tree.size();
+        search_tree.emplace_back(s, no_parent);
     }
     int num_steps = 0;
     // run policy one step at a time until unique min distance is found, no progress can be made, or time-limit reached.
-    while (check_timer()) {
+    while (check_deadline()) {
         std::unordered_map<StateID_type, int> current_successors_distance;
         // evaluate distance of current states
         int min_distance = INT_MAX;
         for (auto const id: current_successors) {
-            auto successor = simEnv.get_state(id);
-            const auto d = distance_to_avoid->evaluate(successor);
+            const auto d = distance_to_avoid->evaluate(simEnv.get_state(id));
             if (d < min_distance) { min_distance = d; }
             current_successors_distance[id] = d;
         }
@@ -90,32 +94,33 @@ std::pair<std::unique_ptr<State>, std::vector<StateID_type>> PolicyRunSampler::s
         // check if all states are terminal
         bool all_terminal =
             std::all_of(current_successors.begin(), current_successors.end(), [this](const auto& state) {
-                return is_terminal(simEnv.get_state(state));
+                return is_terminal(state);
             });
         if (all_terminal) { break; }
 
         // expand all states
-        std::unordered_set<StateID_type> new_successors;
+        new_successors.clear();
         for (auto s: current_successors) {
+            const auto node_index = search_tree_index[s];
             if (is_unsafe(s)) {
-                auto path = reconstruct_path(*search_tree[s], true);
-                return std::make_pair(simEnv.get_state(s).to_ptr(), path);
+                auto path = reconstruct_path(node_index, true);
+                return std::make_pair(s, path);
             }
-            auto successors = get_policy_successors(s); // single step
-            // add all child states
-            for (const auto& state: successors) {
-                auto child_id = state->get_id();
-                if (search_tree.count(child_id) || current_successors.count(child_id)) { continue; }
+            // add all child states (single step)
+            const auto successors = get_policy_successors(s);
+            for (const auto child_id: successors->ids) {
+                if (search_tree_index.count(child_id) || current_successors.count(child_id)) { continue; }
                 new_successors.insert(child_id);
-                search_tree[child_id] = std::make_unique<SearchNode>(child_id, search_tree[s].get());
+                search_tree_index[child_id] = search_tree.size();
+                search_tree.emplace_back(child_id, node_index);
             }
         }
         if (new_successors.empty()) { break; } // do not update frontier
-        current_successors = new_successors;
+        std::swap(current_successors, new_successors);
         if (max_policy_run_length == ++num_steps) { break; }
     }
 
-    // if (successors_to_distance.empty() && timer.is_expired()) { // policy run sampling didn't run.
+    // if (successors_to_distance.empty() && deadline.is_expired()) { // policy run sampling didn't run.
     //     return std::make_pair<std::unique_ptr<State>, std::vector<StateID_type>>(nullptr, {});
     // }
 
@@ -123,48 +128,43 @@ std::pair<std::unique_ptr<State>, std::vector<StateID_type>> PolicyRunSampler::s
     // all leaves of a certain state will have the same distance.
     std::vector<StateID_type> state_ids;
     std::vector<int> distances;
+    state_ids.reserve(successors_to_distance.size());
+    distances.reserve(successors_to_distance.size());
     for (const auto& [s, d]: successors_to_distance) {
         state_ids.push_back(s);
-        distances.push_back(successors_to_distance[s]);
+        distances.push_back(d);
     }
 
     // return leaf state greedily or sampled based on distance.
-    auto selected_state =
-        use_probabilistic_sampling ? sample_successor(state_ids, distances) : greedy_selection(state_ids, distances);
-    auto path = reconstruct_path(*search_tree[selected_state->get_id()], false);
-    return std::make_pair(std::move(selected_state), path);
+    const auto selected_state =
+        use_probabilistic_sampling ? sample_successor(state_ids, distances, rng)
+                                   : greedy_selection(state_ids, distances, rng);
+    auto path = reconstruct_path(search_tree_index[selected_state], false);
+    return std::make_pair(selected_state, path);
 }
 
 /// @return all policy induced successor states of a state.
-std::vector<std::unique_ptr<State>> PolicyRunSampler::get_policy_successors(StateID_type state_id) const {
-    std::vector<std::unique_ptr<State>> successors;
-    auto state = simEnv.get_state(state_id);
-    const ActionLabel_type action_label = policy.evaluate(state);
-    const auto successor_ids = simEnv.compute_successors(state, action_label);
-    for (const auto& id: successor_ids) {
-        auto successor = simEnv.get_state(id).to_ptr();
-        successors.push_back(std::move(successor));
-    }
-    return successors;
+StartGenerator::SuccessorCache::SuccessorsHandle PolicyRunSampler::get_policy_successors(StateID_type state_id) {
+    const ActionLabel_type action_label = policy.evaluate(simEnv.get_state(state_id));
+    return successor_cache.successors(state_id, action_label);
 }
 
 /**
     * Selects the states with minimum distance.
     * If multiple states have min distance than return uniformly random one.
 */
-std::unique_ptr<State> PolicyRunSampler::greedy_selection(
+StateID_type PolicyRunSampler::greedy_selection(
     const std::vector<StateID_type>& successors,
-    const std::vector<int>& distances) {
+    const std::vector<int>& distances,
+    StartGenerator::RngStream& rng) {
     // get successors with min distance and return uniformly random state.
     const int min_distance = *std::min_element(distances.begin(), distances.end());
     std::vector<StateID_type> minimal_states;
     for (size_t i = 0; i < distances.size(); ++i) {
         if (distances[i] == min_distance) { minimal_states.push_back(successors[i]); }
     }
-    if (minimal_states.size() > 1) {
-        return simEnv.get_state(minimal_states[PLAJA_GLOBAL::rng->index(minimal_states.size())]).to_ptr();
-    }
-    return simEnv.get_state(minimal_states[0]).to_ptr();
+    if (minimal_states.size() > 1) { return minimal_states[rng.index(minimal_states.size())]; }
+    return minimal_states[0];
 }
 
 /**
@@ -175,14 +175,18 @@ std::unique_ptr<State> PolicyRunSampler::greedy_selection(
     * @param successors sample set of successor states.
     * @param distances values on which the softmax is applied.
     *
-    * @return state from the distribution.
+    * @return ID of the state from the distribution.
  */
-std::unique_ptr<State> PolicyRunSampler::sample_successor(
+StateID_type PolicyRunSampler::sample_successor(
     const std::vector<StateID_type>& successors,
-    const std::vector<int>& distances) {
+    const std::vector<int>& distances,
+    StartGenerator::RngStream& rng) {
     // if distances are the same return uniformly random state.
     if (std::adjacent_find(distances.begin(), distances.end(), std::not_equal_to<>()) == distances.end()) {
-        return sample_from_distribution(successors, std::vector<double>(successors.size(), 1.0 / successors.size()));
+        return sample_from_distribution(
+            successors,
+            std::vector<double>(successors.size(), 1.0 / successors.size()),
+            rng);
     }
 
     // compute softmax values
@@ -197,7 +201,7 @@ std::unique_ptr<State> PolicyRunSampler::sample_successor(
     softmax_probabilities.reserve(exp_values.size());
     for (auto d: exp_values) { softmax_probabilities.push_back(d / sum_exp); }
 
-    return sample_from_distribution(successors, softmax_probabilities);
+    return sample_from_distribution(successors, softmax_probabilities, rng);
 }
 
 /**
@@ -205,19 +209,21 @@ std::unique_ptr<State> PolicyRunSampler::sample_successor(
  *
  * @param states list of states to sample from.
  * @param probabilities list of probabilities corresponding to a discrete probability distribution of the states.
+ * @param rng random number stream to draw from.
  *
- * @return State from the distribution.
+ * @return ID of the state from the distribution.
  */
-std::unique_ptr<State> PolicyRunSampler::sample_from_distribution(
+StateID_type PolicyRunSampler::sample_from_distribution(
     const std::vector<StateID_type>& states,
-    const std::vector<double>& probabilities) {
-    const auto p = PLAJA_GLOBAL::rng->prob();
+    const std::vector<double>& probabilities,
+    StartGenerator::RngStream& rng) {
+    const auto p = rng.prob();
     double cumulative_probability = 0.0;
     for (size_t i = 0; i < probabilities.size(); ++i) {
         cumulative_probability += probabilities[i];
-        if (p <= cumulative_probability) { return simEnv.get_state(states[i]).to_ptr(); }
+        if (p <= cumulative_probability) { return states[i]; }
     }
-    return simEnv.get_state(states.back()).to_ptr();
+    return states.back();
 }
 
 /**
@@ -243,8 +249,8 @@ bool PolicyRunSampler::unique_min_exists(std::unordered_map<StateID_type, int>&
 }
 
 /// @return true if state has no successor states.
-bool PolicyRunSampler::is_terminal(const State& state) {
-    const bool dead_end = simEnv.extract_applicable_actions(state, true).empty();
+bool PolicyRunSampler::is_terminal(const StateID_type id) {
+    const bool dead_end = successor_cache.applicable_actions(id)->empty();
     if (dead_end) { search_stats.inc_attr_unsigned(PLAJA::StatsUnsigned::DEAD_ENDS); }
     return dead_end;
 }
@@ -255,23 +261,21 @@ bool PolicyRunSampler::is_unsafe(const StateID_type& id) const {
     return rlt;
 }
 
-std::vector<StateID_type> PolicyRunSampler::reconstruct_path(const SearchNode& node, const bool unsafe_node) {
+std::vector<StateID_type> PolicyRunSampler::reconstruct_path(const std::size_t node_index, const bool unsafe_node) {
     std::vector<StateID_type> path;
 
-    if (!unsafe_node) { path.push_back(node.id); }
-    auto current_node = node.parent;
-    while (current_node) {
-        // std::cout << current_node->id << ",";
-        path.push_back(current_node->id);
-        current_node = current_node->parent;
+    if (!unsafe_node) { path.push_back(search_tree[node_index].id); }
+    auto current_index = search_tree[node_index].parent;
+    while (current_index != no_parent) {
+        path.push_back(search_tree[current_index].id);
+        current_index = search_tree[current_index].parent;
     }
-    // std::cout << "path size: " << path.size() << std::endl;
     return path;
 }
 
-/// checks if timer expired and handles statistics
-bool PolicyRunSampler::check_timer() const {
-    if (!timer.is_expired()) { return true; }
+/// checks if the deadline expired and handles statistics
+bool PolicyRunSampler::check_deadline() const {
+    if (!deadline.is_expired()) { return true; }
     if (per_iter_stats) { per_iter_stats->inc_unsigned(PLAJA::StatsUnsigned::TIME_LIMIT_REACHED, 1); }
     return false;
 }
@@ -8,8 +8,14 @@
 #include "../../../utils/rng.h"
 #include "../../smt/bias_functions/distance_function.h"
 #include "../start_generation_statistics.h"
-#include "../../fd_adaptions/timer.h"
+#include "../deadline.h"
+#include "policy_cache.h"
+#include "rng_stream.h"
+#include "successor_cache.h"
 #include <memory>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
 
 /**
  * @brief This class implements the policy run sampling algorithm.
@@ -28,51 +34,63 @@ private:
 
     // simulation:
     const SimulationEnvironment& simEnv;
-    const Policy& policy;
+    StartGenerator::SuccessorCache& successor_cache;
+    StartGenerator::PolicyCache& policy;
 
     //Policy run sampling:
-    Timer& timer;
+    const StartGenerator::Deadline& deadline; // of the calling testing phase.
     std::unique_ptr<Bias::DistanceFunction> distance_to_avoid;
     bool use_probabilistic_sampling;
     int max_policy_run_length;
 
     // path caching
+    static constexpr std::size_t no_parent = -1;
     struct SearchNode {
         StateID_type id;
-        SearchNode* parent;
+        std::size_t parent; // index into search_tree, no_parent for roots.
 
-        SearchNode(const StateID_type id,SearchNode* parent_ptr) : id(id), parent(parent_ptr) {}
+        SearchNode(const StateID_type id, const std::size_t parent_index) : id(id), parent(parent_index) {}
     };
 
+    // search buffers, reused across calls to avoid per-step allocations.
+    std::vector<SearchNode> search_tree;
+    std::unordered_map<StateID_type, std::size_t> search_tree_index;
+    std::unordered_set<StateID_type> current_successors; // frontier
+    std::unordered_set<StateID_type> new_successors;
+
     PLAJA::StatsBase& search_stats;
     StartGenerationStatistics* per_iter_stats;
 
-    std::unique_ptr<State> sample_successor(
+    static StateID_type sample_successor(
         const std::vector<StateID_type>& successors,
-        const std::vector<int>& distances);
+        const std::vector<int>& distances,
+        StartGenerator::RngStream& rng);
 
-    std::unique_ptr<State> greedy_selection(
+    static StateID_type greedy_selection(
         const std::vector<StateID_type>& successors,
-        const std::vector<int>& distances);
+        const std::vector<int>& distances,
+        StartGenerator::RngStream& rng);
 
-    std::unique_ptr<State> sample_from_distribution(
+    static StateID_type sample_from_distribution(
         const std::vector<StateID_type>& states,
-        const std::vector<double>& probabilities);
+        const std::vector<double>& probabilities,
+        StartGenerator::RngStream& rng);
 
-    [[nodiscard]] std::vector<std::unique_ptr<State>> get_policy_successors(StateID_type state_id) const;
+    [[nodiscard]] StartGenerator::SuccessorCache::SuccessorsHandle get_policy_successors(StateID_type state_id);
 
     bool unique_min_exists(std::unordered_map<StateID_type, int>& successors_to_distance);
-    [[nodiscard]] bool is_terminal(const State& state);
+    [[nodiscard]] bool is_terminal(StateID_type id);
     [[nodiscard]] bool is_unsafe(const StateID_type& id) const;
-    std::vector<StateID_type> reconstruct_path(const SearchNode& node,bool unsafe_node);
-    bool check_timer() const;
+    std::vector<StateID_type> reconstruct_path(std::size_t node_index, bool unsafe_node);
+    bool check_deadline() const;
 
 
 public:
     PolicyRunSampler(
-        Timer& timer,
+        const StartGenerator::Deadline& deadline,
         const SimulationEnvironment& simulationEnv,
-        const Policy& policy,
+        StartGenerator::SuccessorCache& successor_cache,
+        StartGenerator::PolicyCache& policy,
         const Expression& start_condition,
         const Expression& unsafety_condition,
         const ModelZ3& model_z3,
@@ -84,7 +102,10 @@ public:
     ~PolicyRunSampler();
     DELETE_CONSTRUCTOR(PolicyRunSampler)
 
-    std::pair<std::unique_ptr<State>,std::vector<StateID_type>> sample_run(const std::vector<StateID_type>& successor_ids);
+    /// @param rng random number stream of the calling trajectory.
+    std::pair<StateID_type, std::vector<StateID_type>> sample_run(
+        const std::vector<StateID_type>& successor_ids,
+        StartGenerator::RngStream& rng);
 
 };
 
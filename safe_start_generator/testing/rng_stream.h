@@ -0,0 +1,87 @@
+//
+// Created by Daniel Sherbakov in 2025.
+//
+
+#ifndef RNG_STREAM_H
+#define RNG_STREAM_H
+
+#include <cstddef>
+#include <cstdint>
+
+namespace StartGenerator {
+
+    /**
+     * @brief Counter-based random number stream.
+     *
+     * The i-th draw of a stream is a SplitMix64 finalization of (key, i), where the key is derived from a global seed
+     * and the stream id. Hence, a stream does not share state with any other stream, and the draws of a stream only
+     * depend on the seed and its id, not on which thread uses it or how many other streams exist.
+     *
+     * Provides the subset of the interface of `PLAJA_GLOBAL::rng` used in testing.
+     */
+    class RngStream {
+    public:
+        RngStream(const uint64_t seed, const uint64_t stream_id):
+            key(mix(seed ^ mix(stream_id + golden_gamma))) {}
+
+        uint64_t next() { return mix(key + golden_gamma * ++counter); }
+
+        /// @return uniform value in [0,1).
+        double prob() { return static_cast<double>(next() >> 11) * 0x1.0p-53; }
+
+        /// @return uniform index in [0,n), by the multiply-shift method (bias below n / 2^64).
+        std::size_t index(const std::size_t n) { return static_cast<std::size_t>(mul_high(next(), n)); }
+
+    private:
+        static constexpr uint64_t golden_gamma = 0x9E3779B97F4A7C15ULL;
+        uint64_t key;
+        uint64_t counter = 0;
+
+        static uint64_t mix(uint64_t z) {
+            z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+            z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+            return z ^ (z >> 31);
+        }
+
+        /// @return upper 64 bits of the 128-bit product, from 32-bit halves to avoid non-standard 128-bit integers.
+        static uint64_t mul_high(const uint64_t a, const uint64_t b) {
+            const uint64_t a_lo = a & 0xFFFFFFFFULL;
+            const uint64_t a_hi = a >> 32;
+            const uint64_t b_lo = b & 0xFFFFFFFFULL;
+            const uint64_t b_hi = b >> 32;
+            const uint64_t lo_lo = a_lo * b_lo;
+            const uint64_t hi_lo = a_hi * b_lo;
+            const uint64_t lo_hi = a_lo * b_hi;
+            const uint64_t cross = (lo_lo >> 32) + (hi_lo & 0xFFFFFFFFULL) + lo_hi;
+            return a_hi * b_hi + (hi_lo >> 32) + (cross >> 32);
+        }
+    };
+
+    /**
+     * @brief Hands out random number streams derived from a single seed, keyed by the caller.
+     *
+     * Streams are keyed by what they are used for, e.g., the k-th trajectory of a testing phase always uses stream k of
+     * the factory derived for that phase. Hence, results do not depend on the order in which threads request streams.
+     * Independent families of streams (phases, components) are separated by `derive`.
+     */
+    class RngStreamFactory {
+    public:
+        explicit RngStreamFactory(const uint64_t seed):
+            seed(seed) {}
+
+        [[nodiscard]] RngStream stream(const uint64_t stream_id) const { return { seed, stream_id }; }
+
+        /// @return factory of an independent family of streams.
+        [[nodiscard]] RngStreamFactory derive(const uint64_t family) const {
+            return RngStreamFactory(RngStream(seed, family).next());
+        }
+
+        [[nodiscard]] uint64_t get_seed() const { return seed; }
+
+    private:
+        uint64_t seed;
+    };
+
+} // namespace StartGenerator
+
+#endif //RNG_STREAM_H
@@ -0,0 +1,205 @@
+//
+// Created by Daniel Sherbakov in 2025.
+//
+
+#include "splitting_search.h"
+
+#include "../../../parser/ast/expression/expression.h"
+#include "../../factories/configuration.h"
+#include "../../factories/safe_start_generator/safe_start_generator_options.h"
+#include "../../fd_adaptions/state.h"
+#include "../../non_prob_search/policy/policy.h"
+#include "../../smt/model/model_z3.h"
+#include "../../stats/stats_base.h"
+#include "../start_generation_statistics.h"
+#include "../start_generator_options.h"
+
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+
+SplittingSearch::SplittingSearch(
+    const PLAJA::Configuration& config,
+    const StartGenerator::Deadline& deadline,
+    SimulationEnvironment& simulation_environment,
+    StartGenerator::SuccessorCache& successor_cache,
+    StartGenerator::PolicyCache& policy,
+    const Expression& unsafety_condition,
+    StartGenerator::StartSampler* start_sampler,
+    const StartGenerator::RngStreamFactory& rng_streams,
+    StartGenerator::PolicyEnvelope& envelope,
+    PLAJA::StatsBase& search_statistics,
+    StartGenerationStatistics* per_iteration_stats):
+    unsafety_condition(unsafety_condition),
+    start_sampler(start_sampler),
+    sim_env(simulation_environment),
+    successor_cache(successor_cache),
+    policy(policy),
+    deadline(deadline),
+    rng_streams(rng_streams),
+    envelope(envelope),
+    distance_to_unsafety(std::make_unique<Bias::DistanceFunction>(
+        unsafety_condition,
+        *config.get_sharable_as_const<ModelZ3>(PLAJA::SharableKey::MODEL_Z3),
+        Bias::DistanceFunctionType::DistanceToTarget)),
+    levels(std::max(1, PLAJA_OPTION::START_GENERATOR::get_int_option(config, PLAJA_OPTION::splitting_levels))),
+    factor(std::max(1, PLAJA_OPTION::START_GENERATOR::get_int_option(config, PLAJA_OPTION::splitting_factor))),
+    terminate_on_cycles(config.is_flag_set(PLAJA_OPTION::terminate_on_cycles)),
+    calibrate(config.is_flag_set(PLAJA_OPTION::splitting_calibration)),
+    search_stats(search_statistics),
+    per_iteration_stats(per_iteration_stats) {}
+
+SplittingSearch::~SplittingSearch() = default;
+
+/**
+ * Runs splitting for the phase. With calibration and a time limit, plain rollouts run for the first share of the phase
+ * instead, and the rates of distinct unsafe states found by both are reported. Afterwards, unsafety is propagated
+ * backwards through all transitions explored so far.
+ *
+ * @return State IDs of states along unsafe paths identified excluding the unsafe states.
+ */
+std::unordered_set<StateID_type> SplittingSearch::identify_unsafe_paths() {
+    if (not calibrate) {
+        search(deadline, true);
+    } else if (not deadline.is_bounded()) {
+        PLAJA_LOG("Splitting: calibration requires a time limit, skipped.")
+        search(deadline, true);
+    } else {
+        // the caches are not cleared, so splitting runs on the states the rollouts brought into them.
+        const auto timed_search = [this](const StartGenerator::Deadline& until, const bool split) {
+            const auto begin = std::chrono::steady_clock::now();
+            const auto num_states = search(until, split);
+            const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+            return seconds > 0 ? static_cast<double>(num_states) / seconds : 0;
+        };
+        const double rollout_rate = timed_search(deadline.limit(deadline.remaining() * calibration_share), false);
+        const double splitting_rate = timed_search(deadline, true);
+
+        std::cout << "Splitting: " << std::fixed << std::setprecision(2) << splitting_rate
+                  << " unsafe states/s, plain rollouts: " << rollout_rate << " unsafe states/s";
+        if (rollout_rate > 0) { std::cout << " (" << splitting_rate / rollout_rate << "x)"; }
+        std::cout << '\n';
+        if (per_iteration_stats) { per_iteration_stats->set_unsafe_state_rates(rollout_rate, splitting_rate); }
+    }
+
+    const auto propagated = envelope.propagate_unsafety();
+    const auto num_on_paths = unsafe_state_ids.size();
+    unsafe_state_ids.insert(propagated.begin(), propagated.end());
+    for (const auto id: unsafe_state_ids) { safe_state_ids.erase(id); }
+    if (per_iteration_stats) {
+        per_iteration_stats->set_propagated_unsafe_states(unsafe_state_ids.size() - num_on_paths);
+    }
+    return unsafe_state_ids;
+}
+
+std::size_t SplittingSearch::search(const StartGenerator::Deadline& until, const bool split) {
+    std::unordered_set<StateID_type> found; // by this mode, the other one may have found some before.
+    while (not until.is_expired()) {
+        const auto start_state_vals = start_sampler->sample_state();
+        if (not start_state_vals) {
+            PLAJA_LOG("... Stopping: No start state found.")
+            break;
+        }
+        const auto start_id = sim_env.get_state(*start_state_vals).get_id();
+        search_stats.inc_attr_unsigned(PLAJA::StatsUnsigned::START_STATES);
+
+        path_nodes.clear();
+        path_nodes.push_back({ start_id, no_parent });
+        start_distance = distance_to_unsafety->evaluate(sim_env.get_state(start_id));
+        open.push_back({ 0, 0, 0, never_pruned, rng_streams.stream(num_trajectories++) });
+
+        // depth-first, so the clones of a trajectory run before its siblings and the population stays small.
+        while (not open.empty() and not until.is_expired()) {
+            auto trajectory = open.back();
+            open.pop_back();
+            switch (run(trajectory, split)) {
+                case Outcome::Unsafe: {
+                    search_stats.inc_attr_unsigned(PLAJA::StatsUnsigned::UNSAFE_PATHS);
+                    add_path(trajectory.tip, found, false);
+                    break;
+                }
+                case Outcome::Safe: add_path(trajectory.tip, safe_state_ids, true); break;
+                case Outcome::Pruned: break;
+            }
+        }
+        open.clear();
+    }
+    unsafe_state_ids.insert(found.begin(), found.end());
+    return found.size();
+}
+
+/**
+ * Simulates the policy from the tip of the trajectory, cloning it whenever it crosses the next threshold.
+ *
+ * @param split whether to clone and prune, plain rollout otherwise.
+ */
+SplittingSearch::Outcome SplittingSearch::run(Trajectory& trajectory, const bool split) {
+    while (true) {
+        const auto state_id = path_nodes[trajectory.tip].id;
+        const auto state = sim_env.get_state(state_id);
+        if (unsafety_condition.evaluate_integer(state)) {
+            envelope.mark_unsafe(state_id);
+            return Outcome::Unsafe;
+        }
+        if (trajectory.length >= path_length_limit) { return Outcome::Safe; }
+
+        ActionLabel_type action_label;
+        bool is_choice;
+        {
+            const auto applicable_actions = successor_cache.applicable_actions(state_id);
+            if (applicable_actions->empty()) {
+                search_stats.inc_attr_unsigned(PLAJA::StatsUnsigned::DEAD_ENDS);
+                return Outcome::Safe;
+            }
+            action_label = applicable_actions->front();
+            is_choice = applicable_actions->size() > 1;
+        }
+        // as in policy execution, the policy is only queried at choice points.
+        if (is_choice) { action_label = policy.evaluate(state); }
+
+        const auto successors = successor_cache.successors(state_id, action_label);
+        if (successors->empty()) { return Outcome::Safe; }
+        const auto successor_id = successors->sample(trajectory.rng);
+        envelope.add_transition(state_id, successor_id);
+        if (terminate_on_cycles and is_on_path(successor_id, trajectory.tip)) {
+            search_stats.inc_attr_unsigned(PLAJA::StatsUnsigned::CYCLES);
+            return Outcome::Safe;
+        }
+        path_nodes.push_back({ successor_id, trajectory.tip });
+        trajectory.tip = path_nodes.size() - 1;
+        ++trajectory.length;
+
+        if (not split) { continue; }
+        const int level = level_of(successor_id);
+        if (level < trajectory.birth_level) { return Outcome::Pruned; }
+        if (level > trajectory.level) {
+            trajectory.level = level;
+            for (int clone = 1; clone < factor and open.size() < max_population; ++clone) {
+                const auto clone_rng = rng_streams.stream(num_trajectories++);
+                open.push_back({ trajectory.tip, trajectory.length, level, level, clone_rng });
+            }
+        }
+    }
+}
+
+/// @return number of thresholds between the start state of the current trajectories and the state, negative if further.
+int SplittingSearch::level_of(const StateID_type state_id) const {
+    if (start_distance <= 0) { return levels; }
+    const int distance = distance_to_unsafety->evaluate(sim_env.get_state(state_id));
+    return static_cast<int>(std::floor(levels * static_cast<double>(start_distance - distance) / start_distance));
+}
+
+bool SplittingSearch::is_on_path(const StateID_type state_id, const std::size_t tip) const {
+    for (auto node = tip; node != no_parent; node = path_nodes[node].parent) {
+        if (path_nodes[node].id == state_id) { return true; }
+    }
+    return false;
+}
+
+void SplittingSearch::add_path(
+    const std::size_t tip,
+    std::unordered_set<StateID_type>& state_ids,
+    const bool include_tip) const {
+    auto node = include_tip ? tip : path_nodes[tip].parent;
+    for (; node != no_parent; node = path_nodes[node].parent) { state_ids.insert(path_nodes[node].id); }
+}
@@ -0,0 +1,123 @@
+//
+// Created by Daniel Sherbakov in 2025.
+//
+
+#ifndef SPLITTING_SEARCH_H
+#define SPLITTING_SEARCH_H
+
+#include "../../../utils/default_constructors.h"
+#include "../../successor_generation/simulation_environment.h"
+#include "../../smt/bias_functions/distance_function.h"
+#include "../deadline.h"
+#include "policy_cache.h"
+#include "policy_envelope.h"
+#include "rng_stream.h"
+#include "start_sampler.h"
+#include "successor_cache.h"
+
+#include <limits>
+#include <memory>
+#include <unordered_set>
+#include <vector>
+
+class StartGenerationStatistics;
+
+/**
+ * @brief Multilevel splitting (RESTART) search for unsafe paths, for models where unsafety is rare under the policy.
+ *
+ * The distance of a state to the unsafety condition (`Bias::DistanceFunction`) defines its importance. The distance of
+ * the start state of a trajectory is divided into `levels` equally spaced thresholds; a trajectory that crosses the
+ * next threshold towards the unsafety condition is cloned `factor - 1` times, and each clone continues from the
+ * crossing state with its own random stream. A clone that falls back below the threshold it was cloned at is pruned,
+ * so effort is spent on the trajectories that get closer to the unsafety condition.
+ *
+ * The first part of the phase runs plain rollouts, i.e., without splitting, to measure the rate of distinct unsafe
+ * states found per second that splitting is compared against. Unsafe paths are no measure here, since the clones of a
+ * trajectory share its prefix and so add paths but hardly new states. Both modes start on cleared caches, so that
+ * neither profits from the successors and decisions the other computed.
+ */
+class SplittingSearch {
+public:
+    SplittingSearch(
+        const PLAJA::Configuration& config,
+        const StartGenerator::Deadline& deadline,
+        SimulationEnvironment& simulation_environment,
+        StartGenerator::SuccessorCache& successor_cache,
+        StartGenerator::PolicyCache& policy,
+        const Expression& unsafety_condition,
+        StartGenerator::StartSampler* start_sampler,
+        const StartGenerator::RngStreamFactory& rng_streams,
+        StartGenerator::PolicyEnvelope& envelope,
+        PLAJA::StatsBase& search_statistics,
+        StartGenerationStatistics* per_iteration_stats);
+    ~SplittingSearch();
+    DELETE_CONSTRUCTOR(SplittingSearch)
+
+    /// @return IDs of the states along unsafe paths, excluding the unsafe states.
+    std::unordered_set<StateID_type> identify_unsafe_paths();
+
+    /// @return states of trajectories that did not reach the unsafety condition, and cannot reach it as far as known.
+    [[nodiscard]] const std::unordered_set<StateID_type>& get_safe_state_ids() const { return safe_state_ids; }
+
+private:
+    static constexpr int path_length_limit = 1000;
+    /// share of the phase spent on plain rollouts when calibrating.
+    static constexpr double calibration_share = 0.1;
+    /// open trajectories of one start state, clones beyond are not created.
+    static constexpr std::size_t max_population = 1024;
+
+    const Expression& unsafety_condition;
+    StartGenerator::StartSampler* start_sampler;
+    SimulationEnvironment& sim_env;
+    StartGenerator::SuccessorCache& successor_cache;
+    StartGenerator::PolicyCache& policy;
+    const StartGenerator::Deadline deadline; // of this testing phase.
+    const StartGenerator::RngStreamFactory rng_streams;
+    uint64_t num_trajectories = 0; // keys the stream of the next trajectory.
+    StartGenerator::PolicyEnvelope& envelope;
+    std::unique_ptr<Bias::DistanceFunction> distance_to_unsafety;
+    const int levels;
+    const int factor;
+    const bool terminate_on_cycles;
+    const bool calibrate; // against plain rollouts.
+
+    /* Trajectories of one start state share their prefixes in a tree of path nodes. */
+    static constexpr std::size_t no_parent = -1;
+    static constexpr int never_pruned = std::numeric_limits<int>::min(); // birth level of original trajectories.
+    struct PathNode {
+        StateID_type id;
+        std::size_t parent; // index into path_nodes.
+    };
+    struct Trajectory {
+        std::size_t tip; // index into path_nodes.
+        int length;
+        int level;       // highest threshold crossed.
+        int birth_level; // threshold the trajectory was cloned at, it is pruned below.
+        StartGenerator::RngStream rng;
+    };
+    enum class Outcome {
+        Unsafe,
+        Safe,
+        Pruned,
+    };
+    std::vector<PathNode> path_nodes;
+    std::vector<Trajectory> open;
+    int start_distance = 0;
+
+    std::unordered_set<StateID_type> unsafe_state_ids;
+    std::unordered_set<StateID_type> safe_state_ids;
+
+    PLAJA::StatsBase& search_stats;
+    StartGenerationStatistics* per_iteration_stats;
+
+    /// runs trajectories from sampled start states until the deadline.
+    /// @return number of distinct states along the unsafe paths found.
+    std::size_t search(const StartGenerator::Deadline& until, bool split);
+    Outcome run(Trajectory& trajectory, bool split);
+    /// @return whether the state occurs on the path ending in the tip.
+    [[nodiscard]] bool is_on_path(StateID_type state_id, std::size_t tip) const;
+    [[nodiscard]] int level_of(StateID_type state_id) const;
+    void add_path(std::size_t tip, std::unordered_set<StateID_type>& state_ids, bool include_tip) const;
+};
+
+#endif //SPLITTING_SEARCH_H
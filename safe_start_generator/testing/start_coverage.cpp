@@ -0,0 +1,42 @@
+//
+// Created by Daniel Sherbakov in 2025.
+//
+
+#include "start_coverage.h"
+
+namespace StartGenerator {
+
+    StartCoverage::StartCoverage(const std::size_t num_bits) {
+        std::size_t size = 64;
+        while (size < num_bits) { size <<= 1; }
+        bits.resize(size / 64, 0);
+        mask = size - 1;
+    }
+
+    bool StartCoverage::insert(const Valuation& valuation) {
+        const auto [h1, h2] = hashes(valuation);
+        bool is_new = false;
+        for (int i = 0; i < num_hashes; ++i) {
+            const auto position = (h1 + i * h2) & mask;
+            auto& word = bits[position >> 6];
+            const uint64_t bit = uint64_t(1) << (position & 63);
+            if (not(word & bit)) {
+                word |= bit;
+                ++num_set;
+                is_new = true;
+            }
+        }
+        return is_new;
+    }
+
+    std::pair<uint64_t, uint64_t> StartCoverage::hashes(const Valuation& valuation) const {
+        // splitmix64 finalizer, ValuationHash alone does not mix the high bits sufficiently.
+        uint64_t h = ValuationHash()(valuation);
+        h = (h ^ (h >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        h = (h ^ (h >> 27)) * 0x94D049BB133111EBULL;
+        h ^= h >> 31;
+        // the step is odd, so the positions are distinct.
+        return { h, (h >> 32 | h << 32) | 1 };
+    }
+
+} // namespace StartGenerator
@@ -0,0 +1,52 @@
+//
+// Created by Daniel Sherbakov in 2025.
+//
+
+#ifndef START_COVERAGE_H
+#define START_COVERAGE_H
+
+#include "../state_valuation.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace StartGenerator {
+
+    /**
+     * @brief Bloom filter of the start states tested so far.
+     *
+     * Once the start region is small, the sampler often returns start states that were already simulated; from a
+     * deterministic segment, these cannot reveal anything new. The filter remembers tested start states in a fixed
+     * number of bits, independent of their number. It has no false negatives, i.e., a new start state may be rejected
+     * as tested (at a rate that grows with the fill), but a tested one is never reported as new.
+     */
+    class StartCoverage {
+    public:
+        static constexpr std::size_t default_bits = std::size_t(1) << 24; // 2 MiB.
+
+        explicit StartCoverage(std::size_t num_bits = default_bits);
+
+        /// marks the start state as tested.
+        /// @return false if it was (likely) tested before.
+        bool insert(const Valuation& valuation);
+
+        /// @return share of set bits, the false positive rate is about its power of the number of hashes.
+        [[nodiscard]] double fill_ratio() const {
+            return static_cast<double>(num_set) / static_cast<double>(bits.size() * 64);
+        }
+
+    private:
+        static constexpr int num_hashes = 4;
+
+        std::vector<uint64_t> bits;
+        std::size_t mask;
+        std::size_t num_set = 0;
+
+        /// the positions of a valuation are derived from two hashes (double hashing).
+        [[nodiscard]] std::pair<uint64_t, uint64_t> hashes(const Valuation& valuation) const;
+    };
+
+} // namespace StartGenerator
+
+#endif //START_COVERAGE_H
@@ -0,0 +1,92 @@
+//
+// Created by Daniel Sherbakov in 2025.
+//
+
+#include "start_sampler.h"
+
+#include "../../../parser/ast/expression/expression.h"
+#include "../../../parser/ast/model.h"
+#include "../../information/model_information.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace StartGenerator {
+
+    StartSampler::StartSampler(
+        InitialStatesEnumerator& enumerator,
+        const Model& model,
+        const Expression& start_condition,
+        const double seed_fraction,
+        const double radius,
+        const RngStream rng):
+        enumerator(enumerator),
+        model_info(model.get_model_information()),
+        start_condition(start_condition),
+        seed_fraction(seed_fraction),
+        rng(rng) {
+        const auto num_vars = model.get_number_variables();
+        lower_bounds.resize(num_vars + 1, 0);
+        upper_bounds.resize(num_vars + 1, 0);
+        radii.resize(num_vars + 1, 0);
+        for (int var = 1; var <= num_vars; ++var) {
+            lower_bounds[var] = model_info.get_lower_bound_int(var);
+            upper_bounds[var] = model_info.get_upper_bound_int(var);
+            const double width = static_cast<double>(upper_bounds[var]) - lower_bounds[var];
+            radii[var] = std::max(1, static_cast<int>(std::lround(radius * width)));
+        }
+        seeds.reserve(max_seeds);
+    }
+
+    StartSampler::~StartSampler() = default;
+
+    std::unique_ptr<StateValues> StartSampler::sample_state() {
+        for (int resample = 0;; ++resample) {
+            auto state = draw();
+            if (not state) { return nullptr; }
+            ++num_samples;
+            if (not coverage) { return state; }
+            if (coverage->insert(to_valuation(*state))) {
+                ++num_distinct;
+                return state;
+            }
+            if (resample >= max_resamples) { return state; }
+        }
+    }
+
+    std::unique_ptr<StateValues> StartSampler::draw() {
+        if (not seeds.empty() and rng.prob() < seed_fraction) {
+            for (int attempt = 0; attempt < max_attempts; ++attempt) {
+                const auto neighbor = perturb(seeds[rng.index(seeds.size())]);
+                auto state = std::make_unique<StateValues>(to_state_values(neighbor, model_info));
+                if (start_condition.evaluate_integer(*state)) {
+                    ++num_seeded;
+                    return state;
+                }
+            }
+        }
+        return enumerator.sample_state();
+    }
+
+    void StartSampler::add_counterexamples(const std::unordered_set<std::unique_ptr<StateBase>>& states) {
+        for (const auto& state: states) {
+            if (seeds.size() < max_seeds) {
+                seeds.push_back(to_valuation(*state));
+            } else {
+                seeds[next_seed] = to_valuation(*state);
+                next_seed = (next_seed + 1) % max_seeds;
+            }
+        }
+    }
+
+    /// uniformly within the radius of each variable, clamped to the domain.
+    Valuation StartSampler::perturb(const Valuation& seed) {
+        auto neighbor = seed;
+        for (std::size_t var = 1; var < radii.size(); ++var) {
+            const int offset = static_cast<int>(rng.index(2 * radii[var] + 1)) - radii[var];
+            neighbor[var] = std::clamp(seed[var] + offset, lower_bounds[var], upper_bounds[var]);
+        }
+        return neighbor;
+    }
+
+} // namespace StartGenerator
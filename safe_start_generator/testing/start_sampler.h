@@ -0,0 +1,95 @@
+//
+// Created by Daniel Sherbakov in 2025.
+//
+
+#ifndef START_SAMPLER_H
+#define START_SAMPLER_H
+
+#include "../../../utils/default_constructors.h"
+#include "../../search/non_prob_search/initial_states_enumerator.h"
+#include "../state_valuation.h"
+#include "rng_stream.h"
+#include "start_coverage.h"
+
+#include <memory>
+#include <unordered_set>
+#include <vector>
+
+class Expression;
+class Model;
+
+namespace StartGenerator {
+
+    /**
+     * @brief Start state sampler of the testing phase, biased towards recent counterexamples.
+     *
+     * Unsafe states found by verification or testing mark where the unsafe region is, and its remaining states are
+     * likely close by. A fraction of the draws therefore perturbs a recent counterexample within a small box
+     * (`radius` of each variable domain) and returns the neighbor if it still satisfies the start condition.
+     * The other draws, and seeded draws that do not hit the start condition, are delegated to the enumerator.
+     *
+     * With a coverage filter, start states tested before are redrawn up to a bound; beyond, the last draw is returned.
+     */
+    class StartSampler {
+    public:
+        StartSampler(
+            InitialStatesEnumerator& enumerator,
+            const Model& model,
+            const Expression& start_condition,
+            double seed_fraction,
+            double radius,
+            RngStream rng);
+        ~StartSampler();
+        DELETE_CONSTRUCTOR(StartSampler)
+
+        /// @return a start state, nullptr if the enumerator does not find any.
+        std::unique_ptr<StateValues> sample_state();
+
+        /// rejects start states contained in the coverage filter, which outlives the sampler.
+        void set_coverage(StartCoverage* start_coverage, int resamples) {
+            coverage = start_coverage;
+            max_resamples = resamples;
+        }
+
+        /// remembers the states as seeds, replacing the oldest ones.
+        void add_counterexamples(const std::unordered_set<std::unique_ptr<StateBase>>& states);
+
+        /// @return number of start states drawn from counterexample neighborhoods since the last reset.
+        [[nodiscard]] std::size_t get_num_seeded() const { return num_seeded; }
+        /// @return number of draws since the last reset, including redrawn duplicates.
+        [[nodiscard]] std::size_t get_num_samples() const { return num_samples; }
+        /// @return number of draws not in the coverage filter since the last reset.
+        [[nodiscard]] std::size_t get_num_distinct() const { return num_distinct; }
+        void reset_counters() { num_seeded = num_samples = num_distinct = 0; }
+
+    private:
+        static constexpr std::size_t max_seeds = 256;
+        /// neighbors tried per seeded draw before falling back to the enumerator.
+        static constexpr int max_attempts = 8;
+
+        InitialStatesEnumerator& enumerator;
+        const ModelInformation& model_info;
+        const Expression& start_condition; // refined in place by the generator.
+        const double seed_fraction;
+        RngStream rng;
+
+        std::vector<int> lower_bounds; // per state index, the location at index 0 is not perturbed.
+        std::vector<int> upper_bounds;
+        std::vector<int> radii;
+
+        std::vector<Valuation> seeds; // ring buffer.
+        std::size_t next_seed = 0;
+        std::size_t num_seeded = 0;
+
+        StartCoverage* coverage = nullptr;
+        int max_resamples = 0;
+        std::size_t num_samples = 0;
+        std::size_t num_distinct = 0;
+
+        [[nodiscard]] std::unique_ptr<StateValues> draw();
+        [[nodiscard]] Valuation perturb(const Valuation& seed);
+    };
+
+} // namespace StartGenerator
+
+#endif //START_SAMPLER_H
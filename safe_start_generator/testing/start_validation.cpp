@@ -0,0 +1,143 @@
+//
+// Created by Daniel Sherbakov in 2025.
+//
+
+#include "start_validation.h"
+
+#include "../../../parser/ast/expression/expression.h"
+#include "../../../parser/ast/model.h"
+#include "../../fd_adaptions/state.h"
+#include "../../information/model_information.h"
+#include "../../non_prob_search/initial_states_enumerator.h"
+#include "../../non_prob_search/policy/policy.h"
+#include "../../successor_generation/simulation_environment.h"
+#include "successor_cache.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <thread>
+#include <utility>
+
+StartValidation::StartValidation(
+    const PLAJA::Configuration& config,
+    const Model& model,
+    const Policy& policy,
+    StartGenerator::PolicyLoader load_policy,
+    const Expression& unsafety_condition,
+    const unsigned num_threads,
+    const std::size_t num_rollouts,
+    const StartGenerator::RngStreamFactory& rng_streams,
+    const StartGenerator::Deadline& deadline):
+    config(config),
+    model(model),
+    policy(policy),
+    load_policy(std::move(load_policy)),
+    unsafety_condition(unsafety_condition),
+    num_threads(std::max(1u, num_threads)),
+    num_rollouts(num_rollouts),
+    rng_streams(rng_streams),
+    deadline(deadline) {}
+
+StartValidation::~StartValidation() = default;
+
+/**
+ * Samples the start states up front, since the enumerator is not thread-safe, and distributes the rollouts among the
+ * workers.
+ */
+StartGenerator::ValidationResult StartValidation::validate(InitialStatesEnumerator& enumerator) {
+    start_states.clear();
+    start_states.reserve(num_rollouts);
+    while (start_states.size() < num_rollouts and not deadline.is_expired()) {
+        const auto start_state_vals = enumerator.sample_state();
+        if (not start_state_vals) { break; }
+        start_states.push_back(StartGenerator::to_valuation(*start_state_vals));
+    }
+
+    // loaded up front on this thread, loading is not thread-safe either.
+    while (worker_policies.size() + 1 < num_threads) { worker_policies.push_back(load_policy()); }
+    std::vector<const Policy*> policies { &policy };
+    for (const auto& worker_policy: worker_policies) { policies.push_back(worker_policy.get()); }
+
+    next_rollout = 0;
+    std::vector<WorkerResult> results(num_threads);
+    std::vector<std::thread> workers;
+    workers.reserve(num_threads);
+    for (unsigned worker = 0; worker < num_threads; ++worker) {
+        workers.emplace_back(
+            &StartValidation::run_worker,
+            this,
+            std::cref(*policies[worker]),
+            std::ref(results[worker]));
+    }
+    for (auto& worker: workers) { worker.join(); }
+
+    StartGenerator::ValidationResult result;
+    std::vector<UnsafeRollout> unsafe_rollouts;
+    for (auto& worker_result: results) {
+        result.rollouts += worker_result.rollouts;
+        result.unsafe += worker_result.unsafe_rollouts.size();
+        for (auto& rollout: worker_result.unsafe_rollouts) {
+            if (not rollout.trace.empty()) { unsafe_rollouts.push_back(std::move(rollout)); }
+        }
+    }
+    // the first unsafe rollouts in start state order, independent of the worker that ran them.
+    std::sort(unsafe_rollouts.begin(), unsafe_rollouts.end(), [](const auto& a, const auto& b) {
+        return a.index < b.index;
+    });
+    for (std::size_t i = 0; i < std::min(max_traces, unsafe_rollouts.size()); ++i) {
+        result.traces.push_back(std::move(unsafe_rollouts[i].trace));
+    }
+
+    // Wilson score interval, which stays informative at rates close to 0.
+    if (result.rollouts > 0) {
+        const double n = static_cast<double>(result.rollouts);
+        const double p = result.rate();
+        const double center = (p + z * z / (2 * n)) / (1 + z * z / n);
+        const double half_width = z * std::sqrt(p * (1 - p) / n + z * z / (4 * n * n)) / (1 + z * z / n);
+        result.lower = std::max(0.0, center - half_width);
+        result.upper = std::min(1.0, center + half_width);
+    }
+
+    std::cout << "Validation: " << result.unsafe << " of " << result.rollouts << " rollouts unsafe, rate "
+              << result.rate() << " in [" << result.lower << ", " << result.upper << "] (95% confidence)." << '\n';
+    if (result.rollouts < num_rollouts) { PLAJA_LOG("... Not all rollouts were run (time limit or no start state).") }
+    return result;
+}
+
+void StartValidation::run_worker(const Policy& worker_policy, WorkerResult& result) {
+    SimulationEnvironment sim_env(config, model); // own state registry per worker.
+    const auto& model_info = model.get_model_information();
+    std::vector<StateID_type> path;
+
+    for (auto index = next_rollout++; index < start_states.size(); index = next_rollout++) {
+        if (deadline.is_expired()) { break; }
+        auto rng = rng_streams.stream(index);
+        path.clear();
+        path.push_back(sim_env.get_state(StartGenerator::to_state_values(start_states[index], model_info)).get_id());
+
+        bool unsafe = false;
+        while (path.size() <= path_length_limit) {
+            const auto state = sim_env.get_state(path.back());
+            if ((unsafe = unsafety_condition.evaluate_integer(state))) { break; }
+            const auto applicable_actions = sim_env.extract_applicable_actions(state, true);
+            if (applicable_actions.empty()) { break; }
+            // as in policy execution, the policy is only queried at choice points.
+            ActionLabel_type action_label = applicable_actions[0];
+            if (applicable_actions.size() > 1) { action_label = worker_policy.evaluate(state); }
+            const auto successors = StartGenerator::Successors::compute(sim_env, state, action_label);
+            if (successors.empty()) { break; }
+            path.push_back(successors.sample(rng));
+        }
+
+        ++result.rollouts;
+        if (not unsafe) { continue; }
+        // at most max_traces of the worker can be among the first ones overall.
+        std::vector<StartGenerator::Valuation> trace;
+        if (result.unsafe_rollouts.size() < max_traces) {
+            trace.reserve(path.size());
+            for (const auto id: path) { trace.push_back(StartGenerator::to_valuation(sim_env.get_state(id))); }
+        }
+        result.unsafe_rollouts.push_back({ index, std::move(trace) });
+    }
+}
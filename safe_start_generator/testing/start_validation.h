@@ -0,0 +1,107 @@
+//
+// Created by Daniel Sherbakov in 2025.
+//
+
+#ifndef START_VALIDATION_H
+#define START_VALIDATION_H
+
+#include "../../../utils/default_constructors.h"
+#include "../deadline.h"
+#include "../state_valuation.h"
+#include "policy_cache.h"
+#include "rng_stream.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace PLAJA {
+    class Configuration;
+}
+class Expression;
+class InitialStatesEnumerator;
+class Model;
+class Policy;
+
+namespace StartGenerator {
+
+    /// empirical unsafe rate of policy rollouts from the final start condition.
+    struct ValidationResult {
+        std::size_t rollouts = 0;
+        std::size_t unsafe = 0;
+        /// Wilson score interval of the unsafe rate.
+        double lower = 0;
+        double upper = 1;
+        /// states from the start state to the unsafe state, of the first unsafe rollouts.
+        std::vector<std::vector<Valuation>> traces;
+
+        [[nodiscard]] double rate() const {
+            return rollouts == 0 ? 0 : static_cast<double>(unsafe) / static_cast<double>(rollouts);
+        }
+    };
+
+}
+
+/**
+ * @brief Statistical validation of the final start condition.
+ *
+ * A start condition reported as safe is backed by verification, up to the approximations used. The validation phase
+ * estimates the remaining failure rate empirically: it samples start states from the condition and runs one policy
+ * rollout from each, in parallel. The rollout of the i-th start state uses the i-th random stream, so the result does
+ * not depend on the number of threads. Policy evaluation is not thread-safe, hence each worker uses a policy instance
+ * of its own.
+ */
+class StartValidation {
+public:
+    StartValidation(
+        const PLAJA::Configuration& config,
+        const Model& model,
+        const Policy& policy,
+        StartGenerator::PolicyLoader load_policy,
+        const Expression& unsafety_condition,
+        unsigned num_threads,
+        std::size_t num_rollouts,
+        const StartGenerator::RngStreamFactory& rng_streams,
+        const StartGenerator::Deadline& deadline);
+    ~StartValidation();
+    DELETE_CONSTRUCTOR(StartValidation)
+
+    /// runs the rollouts from start states of the enumerator, until all are done or the deadline expires.
+    StartGenerator::ValidationResult validate(InitialStatesEnumerator& enumerator);
+
+private:
+    static constexpr std::size_t path_length_limit = 1000;
+    /// violating traces reported.
+    static constexpr std::size_t max_traces = 5;
+    /// two-sided 95% confidence.
+    static constexpr double z = 1.959963984540054;
+
+    const PLAJA::Configuration& config;
+    const Model& model;
+    const Policy& policy; // of the first worker.
+    const StartGenerator::PolicyLoader load_policy;
+    std::vector<std::unique_ptr<Policy>> worker_policies; // of the other workers, loaded once.
+    const Expression& unsafety_condition;
+    const unsigned num_threads;
+    const std::size_t num_rollouts;
+    const StartGenerator::RngStreamFactory rng_streams;
+    const StartGenerator::Deadline deadline;
+
+    std::vector<StartGenerator::Valuation> start_states;
+    std::atomic<std::size_t> next_rollout { 0 };
+
+    struct UnsafeRollout {
+        std::size_t index; // of the start state.
+        std::vector<StartGenerator::Valuation> trace;
+    };
+    struct WorkerResult {
+        std::size_t rollouts = 0;
+        std::vector<UnsafeRollout> unsafe_rollouts; // traces only of the first ones.
+    };
+
+    void run_worker(const Policy& worker_policy, WorkerResult& result);
+};
+
+#endif //START_VALIDATION_H
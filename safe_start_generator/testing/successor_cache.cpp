@@ -0,0 +1,89 @@
+//
+// Created by Daniel Sherbakov in 2025.
+//
+
+#include "successor_cache.h"
+
+#include "../../fd_adaptions/state.h"
+#include "../../successor_generation/simulation_environment.h"
+
+namespace StartGenerator {
+
+    namespace {
+        std::size_t next_power_of_two(std::size_t n) {
+            std::size_t power = 1;
+            while (power < n) { power <<= 1; }
+            return power;
+        }
+    } // namespace
+
+    /// inverse transform sampling, as the simulation samples probabilistic updates.
+    StateID_type Successors::sample(RngStream& rng) const {
+        if (ids.size() == 1) { return ids.front(); }
+        const auto p = rng.prob();
+        double cumulative_probability = 0;
+        for (std::size_t i = 0; i < ids.size(); ++i) {
+            cumulative_probability += probabilities[i];
+            if (p < cumulative_probability) { return ids[i]; }
+        }
+        return ids.back(); // rounding.
+    }
+
+    Successors Successors::compute(
+        const SimulationEnvironment& sim_env,
+        const State& state,
+        const ActionLabel_type action_label) {
+        Successors successors;
+        for (const auto& [id, probability]: sim_env.compute_successor_distribution(state, action_label)) {
+            successors.ids.push_back(id);
+            successors.probabilities.push_back(probability);
+        }
+        return successors;
+    }
+
+    SuccessorCache::SuccessorCache(const SimulationEnvironment& sim_env, const std::size_t capacity):
+        sim_env(sim_env),
+        table(next_power_of_two(capacity)),
+        mask(table.size() - 1) {
+        for (auto& entry: table) { entry.id = -1; }
+    }
+
+    SuccessorCache::Entry& SuccessorCache::get_entry(const StateID_type id) {
+        // Fibonacci hashing spreads consecutive registry IDs over the table.
+        auto& entry = table[(static_cast<std::size_t>(id) * 0x9E3779B97F4A7C15ULL >> 16) & mask];
+        if (entry.id != id) {
+            entry.id = id;
+            entry.actions = nullptr;
+            entry.successors.clear();
+        }
+        return entry;
+    }
+
+    SuccessorCache::Actions SuccessorCache::applicable_actions(const StateID_type id) {
+        auto& entry = get_entry(id);
+        if (entry.actions) {
+            ++hits;
+            return entry.actions;
+        }
+        ++misses;
+        entry.actions = std::make_shared<const std::vector<ActionLabel_type>>(
+            sim_env.extract_applicable_actions(sim_env.get_state(id), true));
+        return entry.actions;
+    }
+
+    SuccessorCache::SuccessorsHandle SuccessorCache::successors(const StateID_type id, const ActionLabel_type action_label) {
+        auto& entry = get_entry(id);
+        for (const auto& [label, successors]: entry.successors) {
+            if (label == action_label) {
+                ++hits;
+                return successors;
+            }
+        }
+        ++misses;
+        entry.successors.emplace_back(
+            action_label,
+            std::make_shared<const Successors>(Successors::compute(sim_env, sim_env.get_state(id), action_label)));
+        return entry.successors.back().second;
+    }
+
+} // namespace StartGenerator
@@ -0,0 +1,87 @@
+//
+// Created by Daniel Sherbakov in 2025.
+//
+
+#ifndef SUCCESSOR_CACHE_H
+#define SUCCESSOR_CACHE_H
+
+#include "../../states/forward_states.h"
+#include "../../using_search.h"
+#include "rng_stream.h"
+
+#include <cstddef>
+#include <memory>
+#include <utility>
+#include <vector>
+
+class SimulationEnvironment;
+
+namespace StartGenerator {
+
+    /// outcomes of an action in a state with their transition probabilities, as distributed by the simulation.
+    struct Successors {
+        std::vector<StateID_type> ids;
+        std::vector<double> probabilities; // of the ids, summing to one.
+
+        [[nodiscard]] bool empty() const { return ids.empty(); }
+        [[nodiscard]] std::size_t size() const { return ids.size(); }
+
+        /// @return a successor drawn by transition probability.
+        StateID_type sample(RngStream& rng) const;
+
+        static Successors
+        compute(const SimulationEnvironment& sim_env, const State& state, ActionLabel_type action_label);
+    };
+
+    /**
+     * @brief Bounded memo table of applicable actions and per-action successors keyed by state ID.
+     *
+     * Testing expands the same states over and over (repeated start states, terminal checks followed by simulation,
+     * policy-run sampling lookahead). The table is direct-mapped: each state ID maps to exactly one slot, and a state
+     * hashing to an occupied slot evicts the previous entry. Hence, memory is bounded by the capacity.
+     *
+     * Since state IDs are stable within the state registry of the simulation environment, the table stays valid
+     * across testing phases.
+     *
+     * Lookups return shared immutable handles, hence results stay valid when later lookups evict their entry.
+     */
+    class SuccessorCache {
+    public:
+        static constexpr std::size_t default_capacity = 1 << 16;
+
+        explicit SuccessorCache(const SimulationEnvironment& sim_env, std::size_t capacity = default_capacity);
+
+        using Actions = std::shared_ptr<const std::vector<ActionLabel_type>>;
+        using SuccessorsHandle = std::shared_ptr<const Successors>;
+
+        Actions applicable_actions(StateID_type id);
+        SuccessorsHandle successors(StateID_type id, ActionLabel_type action_label);
+
+        [[nodiscard]] std::size_t get_hits() const { return hits; }
+        [[nodiscard]] std::size_t get_misses() const { return misses; }
+        [[nodiscard]] double hit_rate() const {
+            return hits + misses == 0 ? 0 : static_cast<double>(hits) / static_cast<double>(hits + misses);
+        }
+        void reset_counters() { hits = misses = 0; }
+
+    private:
+        struct Entry {
+            StateID_type id;
+            Actions actions; // null until computed.
+            std::vector<std::pair<ActionLabel_type, SuccessorsHandle>> successors;
+        };
+
+        const SimulationEnvironment& sim_env;
+        std::vector<Entry> table;
+        std::size_t mask;
+
+        std::size_t hits = 0;
+        std::size_t misses = 0;
+
+        /// @return slot of id, evicting a different state if necessary.
+        Entry& get_entry(StateID_type id);
+    };
+
+} // namespace StartGenerator
+
+#endif //SUCCESSOR_CACHE_H
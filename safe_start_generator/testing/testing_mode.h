@@ -0,0 +1,35 @@
+//
+// Created by Daniel Sherbakov in 2025.
+//
+
+#ifndef TESTING_MODE_H
+#define TESTING_MODE_H
+
+#include <stdexcept>
+#include <string>
+
+namespace Testing {
+    enum class Mode {
+        Rollout,    // sampled policy executions (UnsafePathIdentifier).
+        Exhaustive, // explicit-state exploration of the whole policy envelope (EnvelopeExplorer).
+        Splitting,  // multilevel splitting towards the unsafety condition (SplittingSearch).
+    };
+
+    inline std::string mode_to_string(const Mode mode) {
+        switch (mode) {
+            case Mode::Rollout: return "rollout";
+            case Mode::Exhaustive: return "exhaustive";
+            case Mode::Splitting: return "splitting";
+            default: throw std::invalid_argument("Unknown testing mode");
+        }
+    }
+
+    inline Mode string_to_mode(const std::string& mode_str) {
+        if (mode_str == "rollout") return Mode::Rollout;
+        if (mode_str == "exhaustive") return Mode::Exhaustive;
+        if (mode_str == "splitting") return Mode::Splitting;
+        throw std::invalid_argument("Invalid testing mode string: " + mode_str);
+    }
+}
+
+#endif //TESTING_MODE_H
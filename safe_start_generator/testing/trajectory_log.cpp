@@ -0,0 +1,80 @@
+//
+// Created by Daniel Sherbakov in 2025.
+//
+
+#include "trajectory_log.h"
+
+#include "../../states/state_base.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace StartGenerator {
+
+    TrajectoryLog::TrajectoryLog(const std::string& file_name, const std::size_t state_size):
+        file(std::fopen(file_name.c_str(), "wb")),
+        previous(state_size, 0) {
+        if (not file) { throw std::runtime_error("Cannot open trajectory log: " + file_name); }
+        buffer.reserve(buffer_capacity);
+        buffer.insert(buffer.end(), std::begin(TrajectoryLogFormat::magic), std::end(TrajectoryLogFormat::magic));
+        put<uint32_t>(TrajectoryLogFormat::version);
+        put<uint32_t>(static_cast<uint32_t>(state_size));
+    }
+
+    TrajectoryLog::~TrajectoryLog() {
+        flush();
+        std::fclose(file);
+    }
+
+    void TrajectoryLog::reserve(const std::size_t bytes) {
+        if (buffer.size() + bytes > buffer_capacity) { flush(); }
+    }
+
+    void TrajectoryLog::flush() {
+        if (buffer.empty()) { return; }
+        std::fwrite(buffer.data(), 1, buffer.size(), file);
+        std::fflush(file);
+        buffer.clear();
+    }
+
+    void TrajectoryLog::start(const StateID_type id, const StateBase& state) {
+        reserve(1 + sizeof(int32_t) * (1 + previous.size()));
+        put(TrajectoryLogFormat::Record::Start);
+        put<int32_t>(id);
+        for (std::size_t var = 0; var < previous.size(); ++var) {
+            previous[var] = state.get_int(var);
+            put<int32_t>(previous[var]);
+        }
+        open = true;
+    }
+
+    void TrajectoryLog::step(const ActionLabel_type action, const StateID_type id, const StateBase& state) {
+        if (not open) { return; }
+        reserve(1 + 2 * sizeof(int32_t) + sizeof(uint16_t) * (1 + previous.size()) + sizeof(int32_t) * previous.size());
+        put(TrajectoryLogFormat::Record::Step);
+        put<int32_t>(action);
+        put<int32_t>(id);
+        // count placeholder, patched once the deltas are known.
+        const auto count_offset = buffer.size();
+        put<uint16_t>(0);
+        uint16_t num_deltas = 0;
+        for (std::size_t var = 0; var < previous.size(); ++var) {
+            const int value = state.get_int(var);
+            if (value == previous[var]) { continue; }
+            previous[var] = value;
+            put<uint16_t>(static_cast<uint16_t>(var));
+            put<int32_t>(value);
+            ++num_deltas;
+        }
+        std::copy_n(reinterpret_cast<const char*>(&num_deltas), sizeof(uint16_t), buffer.begin() + count_offset);
+    }
+
+    void TrajectoryLog::end(const Outcome outcome) {
+        if (not open) { return; }
+        reserve(2);
+        put(TrajectoryLogFormat::Record::End);
+        put(outcome);
+        open = false;
+    }
+
+} // namespace StartGenerator
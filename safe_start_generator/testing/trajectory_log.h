@@ -0,0 +1,61 @@
+//
+// Created by Daniel Sherbakov in 2025.
+//
+
+#ifndef TRAJECTORY_LOG_H
+#define TRAJECTORY_LOG_H
+
+#include "../../../utils/default_constructors.h"
+#include "../../states/forward_states.h"
+#include "../../using_search.h"
+#include "trajectory_log_format.h"
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+namespace StartGenerator {
+
+    /**
+     * @brief Append-only binary log of testing trajectories, see `TrajectoryLogFormat`.
+     *
+     * Records are encoded into an in-memory buffer that is written to the file in large blocks, so logging costs a few
+     * stores per step. Steps only record the variables that changed.
+     * Shared by all testing phases; a trajectory left open (e.g., at the time limit) is not terminated by an End record.
+     */
+    class TrajectoryLog {
+    public:
+        using Outcome = TrajectoryLogFormat::Outcome;
+
+        TrajectoryLog(const std::string& file_name, std::size_t state_size);
+        ~TrajectoryLog();
+        DELETE_CONSTRUCTOR(TrajectoryLog)
+
+        void start(StateID_type id, const StateBase& state);
+        void step(ActionLabel_type action, StateID_type id, const StateBase& state);
+
+        /// terminates the current trajectory; no-op if no trajectory is open, so only the first detected outcome counts.
+        void end(Outcome outcome);
+
+        void flush();
+
+    private:
+        static constexpr std::size_t buffer_capacity = 1 << 20;
+
+        std::FILE* file;
+        std::vector<char> buffer;
+        std::vector<int> previous; // valuation of the last logged state.
+        bool open = false;
+
+        template<typename T>
+        void put(const T value) {
+            const auto* bytes = reinterpret_cast<const char*>(&value);
+            buffer.insert(buffer.end(), bytes, bytes + sizeof(T));
+        }
+
+        void reserve(std::size_t bytes);
+    };
+
+} // namespace StartGenerator
+
+#endif //TRAJECTORY_LOG_H
@@ -0,0 +1,61 @@
+//
+// Created by Daniel Sherbakov in 2025.
+//
+
+#ifndef TRAJECTORY_LOG_FORMAT_H
+#define TRAJECTORY_LOG_FORMAT_H
+
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+
+/**
+ * Binary trajectory log format (native byte order), shared by `TrajectoryLog` and `TrajectoryLogReader`.
+ *
+ * header: magic[8] "SSGTRLOG", uint32 version, uint32 state_size (number of integer state variables incl. loc).
+ * records, each starting with a uint8 tag:
+ * - Start: int32 state_id, int32 valuation[state_size].
+ * - Step:  int32 action, int32 state_id, uint16 num_deltas, num_deltas x (uint16 variable, int32 value);
+ *          deltas are relative to the previous state of the trajectory.
+ * - End:   uint8 outcome.
+ * Trajectories are numbered implicitly by the order of their Start records.
+ */
+namespace StartGenerator::TrajectoryLogFormat {
+
+    constexpr char magic[8] = { 'S', 'S', 'G', 'T', 'R', 'L', 'O', 'G' };
+    constexpr uint32_t version = 1;
+
+    enum class Record : uint8_t {
+        Start = 1,
+        Step = 2,
+        End = 3,
+    };
+
+    enum class Outcome : uint8_t {
+        Unsafe,
+        DeadEnd,
+        Cycle,
+        LengthLimit,
+    };
+
+    inline std::string outcome_to_string(const Outcome outcome) {
+        switch (outcome) {
+            case Outcome::Unsafe: return "unsafe";
+            case Outcome::DeadEnd: return "dead_end";
+            case Outcome::Cycle: return "cycle";
+            case Outcome::LengthLimit: return "length_limit";
+            default: throw std::invalid_argument("Unknown trajectory outcome");
+        }
+    }
+
+    inline Outcome string_to_outcome(const std::string& outcome_str) {
+        if (outcome_str == "unsafe") return Outcome::Unsafe;
+        if (outcome_str == "dead_end") return Outcome::DeadEnd;
+        if (outcome_str == "cycle") return Outcome::Cycle;
+        if (outcome_str == "length_limit") return Outcome::LengthLimit;
+        throw std::invalid_argument("Invalid trajectory outcome string: " + outcome_str);
+    }
+
+} // namespace StartGenerator::TrajectoryLogFormat
+
+#endif //TRAJECTORY_LOG_FORMAT_H
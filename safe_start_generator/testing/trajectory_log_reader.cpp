@@ -0,0 +1,82 @@
+//
+// Created by Daniel Sherbakov in 2025.
+//
+
+#include "trajectory_log_reader.h"
+
+#include <algorithm>
+#include <iterator>
+#include <stdexcept>
+
+namespace StartGenerator {
+
+    TrajectoryLogReader::TrajectoryLogReader(const std::string& file_name):
+        in(file_name, std::ios::binary) {
+        if (not in) { throw std::runtime_error("Cannot open trajectory log: " + file_name); }
+        char magic[sizeof(TrajectoryLogFormat::magic)];
+        uint32_t version = 0;
+        in.read(magic, sizeof(magic));
+        if (not in or not std::equal(std::begin(magic), std::end(magic), std::begin(TrajectoryLogFormat::magic))) {
+            throw std::runtime_error("Not a trajectory log: " + file_name);
+        }
+        if (not get(version) or version != TrajectoryLogFormat::version) {
+            throw std::runtime_error("Unsupported trajectory log version: " + file_name);
+        }
+        if (not get(state_size)) { throw std::runtime_error("Truncated trajectory log header: " + file_name); }
+    }
+
+    bool TrajectoryLogReader::read_start(Trajectory& trajectory) {
+        trajectory.index = num_read++;
+        trajectory.steps.clear();
+        trajectory.outcome.reset();
+        trajectory.start_valuation.resize(state_size);
+        if (not get(trajectory.start_id)) { return false; }
+        for (auto& value: trajectory.start_valuation) {
+            if (not get(value)) { return false; }
+        }
+        return true;
+    }
+
+    bool TrajectoryLogReader::next(Trajectory& trajectory) {
+        TrajectoryLogFormat::Record tag {};
+        if (not pending_start) {
+            if (not get(tag)) { return false; }
+            if (tag != TrajectoryLogFormat::Record::Start) { throw std::runtime_error("Expected start of trajectory"); }
+        }
+        pending_start = false;
+        if (not read_start(trajectory)) { return false; }
+
+        while (get(tag)) {
+            switch (tag) {
+                case TrajectoryLogFormat::Record::Start: {
+                    // previous trajectory was left open.
+                    pending_start = true;
+                    return true;
+                }
+                case TrajectoryLogFormat::Record::Step: {
+                    Step step;
+                    uint16_t num_deltas = 0;
+                    if (not get(step.action) or not get(step.state_id) or not get(num_deltas)) { return true; }
+                    step.valuation = trajectory.steps.empty() ? trajectory.start_valuation : trajectory.steps.back().valuation;
+                    for (uint16_t i = 0; i < num_deltas; ++i) {
+                        uint16_t var = 0;
+                        int32_t value = 0;
+                        if (not get(var) or not get(value)) { return true; }
+                        if (var >= state_size) { throw std::runtime_error("Invalid variable index in trajectory log"); }
+                        step.valuation[var] = value;
+                    }
+                    trajectory.steps.push_back(std::move(step));
+                    break;
+                }
+                case TrajectoryLogFormat::Record::End: {
+                    TrajectoryLogFormat::Outcome outcome {};
+                    if (get(outcome)) { trajectory.outcome = outcome; }
+                    return true;
+                }
+                default: throw std::runtime_error("Invalid record in trajectory log");
+            }
+        }
+        return true;
+    }
+
+} // namespace StartGenerator
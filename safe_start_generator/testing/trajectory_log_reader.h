@@ -0,0 +1,65 @@
+//
+// Created by Daniel Sherbakov in 2025.
+//
+
+#ifndef TRAJECTORY_LOG_READER_H
+#define TRAJECTORY_LOG_READER_H
+
+#include "trajectory_log_format.h"
+
+#include <cstdint>
+#include <fstream>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace StartGenerator {
+
+    /**
+     * @brief Sequential reader of logs written by `TrajectoryLog`.
+     *
+     * Independent of PlaJA, so that logs can be inspected offline.
+     * Step valuations are reconstructed from the deltas.
+     */
+    class TrajectoryLogReader {
+    public:
+        struct Step {
+            int32_t action;
+            int32_t state_id;
+            std::vector<int32_t> valuation;
+        };
+
+        struct Trajectory {
+            std::size_t index; // position of the trajectory in the log.
+            int32_t start_id;
+            std::vector<int32_t> start_valuation;
+            std::vector<Step> steps;
+            std::optional<TrajectoryLogFormat::Outcome> outcome; // missing if the trajectory was not terminated.
+        };
+
+        /// @throws std::runtime_error if the file cannot be opened or has an invalid header.
+        explicit TrajectoryLogReader(const std::string& file_name);
+
+        [[nodiscard]] uint32_t get_state_size() const { return state_size; }
+
+        /// @return false at the end of the log; a truncated trailing record ends the log.
+        bool next(Trajectory& trajectory);
+
+    private:
+        std::ifstream in;
+        uint32_t state_size = 0;
+        std::size_t num_read = 0;
+        bool pending_start = false; // a start record was consumed while reading the previous trajectory.
+
+        template<typename T>
+        bool get(T& value) {
+            in.read(reinterpret_cast<char*>(&value), sizeof(T));
+            return static_cast<bool>(in);
+        }
+
+        bool read_start(Trajectory& trajectory);
+    };
+
+} // namespace StartGenerator
+
+#endif //TRAJECTORY_LOG_READER_H
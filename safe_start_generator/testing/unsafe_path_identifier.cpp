@@ -7,7 +7,6 @@
 #include "../../../parser/ast/expression/expression.h"
 #include "../../factories/configuration.h"
 #include "../../factories/safe_start_generator/safe_start_generator_options.h"
-#include "../../fd_adaptions/timer.h"
 #include "../../information/property_information.h"
 #include "../../non_prob_search/policy/policy.h"
 #include "../../stats/stats_base.h"
@@ -16,33 +15,41 @@
 
 UnsafePathIdentifier::UnsafePathIdentifier(
     const PLAJA::Configuration& config,
-    const int time_limit,
+    const StartGenerator::Deadline& deadline,
     SimulationEnvironment& simulation_environment,
-    const Policy& policy,
+    StartGenerator::SuccessorCache& successor_cache,
+    StartGenerator::PolicyCache& policy,
     const Expression& start_condition,
     const Expression& unsafety_condition,
-    InitialStatesEnumerator* enumerator,
+    StartGenerator::StartSampler* start_sampler,
+    const StartGenerator::RngStreamFactory& rng_streams,
+    StartGenerator::PolicyEnvelope& envelope,
+    StartGenerator::TrajectoryLog* trajectory_log,
     PLAJA::StatsBase& search_statistics,
     StartGenerationStatistics* perIterStats,
     const bool terminateCyclesFlag,
     const bool usePolicyRunSampling):
     start_condition(start_condition),
     unsafety_condition(unsafety_condition),
-    start_sampler(enumerator),
+    start_sampler(start_sampler),
     sim_env(simulation_environment),
+    successor_cache(successor_cache),
     policy(policy),
-    timer(std::make_unique<Timer>(time_limit)),
+    deadline(deadline),
+    rng_streams(rng_streams),
+    envelope(envelope),
     policy_run_sampler(nullptr),
     terminate_on_cycles(terminateCyclesFlag),
     search_stats(search_statistics),
     per_iteration_stats(perIterStats),
-    log_path(config.is_flag_set(PLAJA_OPTION::log_path)) {
+    trajectory_log(trajectory_log) {
     if (usePolicyRunSampling) {
         // std::cout << "Using policy run sampling ..." << std::endl;
         sampling_probability = config.get_double_option(PLAJA_OPTION::sampling_probability);
         policy_run_sampler = std::make_unique<PolicyRunSampler>(
-            *timer,
+            this->deadline,
             sim_env,
+            successor_cache,
             policy,
             start_condition,
             unsafety_condition,
@@ -57,31 +64,45 @@ UnsafePathIdentifier::UnsafePathIdentifier(
 /**
  * Search policy envelope for unsafe paths.
  *
+ * After the search, unsafety is propagated backwards through all transitions explored so far, so states of trajectories
+ * that ended safe but can reach an unsafe state are reported as well.
+ *
  * @return State IDs of states along unsafe paths identified excluding the unsafe states.
  */
 std::unordered_set<StateID_type> UnsafePathIdentifier::identify_unsafe_paths() {
     transition_cache.clear(); // clear cache for new execution.
-    while (!timer->is_expired()) {
+    while (!deadline.is_expired()) {
         auto start_state_vals = start_sampler->sample_state();
         PLAJA_ASSERT(start_state_vals)
         if (!start_state_vals) {
             PLAJA_LOG("... Stopping: No start state found.")
             break;
         }
-        auto start_state = sim_env.get_state(*start_state_vals).to_ptr();
+        const auto start_id = sim_env.get_state(*start_state_vals).get_id();
+        trajectory_rng = rng_streams.stream(num_trajectories++);
         search_stats.inc_attr_unsigned(PLAJA::StatsUnsigned::START_STATES);
 
-        path_cache.insert(start_state->get_id());
-        set_current_state(*start_state);
+        path_cache.insert(start_id);
+        set_current_state(start_id);
 
-        if (execute_policy(*start_state)) {
+        if (execute_policy(start_id)) {
             unsafe_path_found = true;
             search_stats.inc_attr_unsigned(PLAJA::StatsUnsigned::UNSAFE_PATHS);
             unsafe_state_ids.insert(path_cache.begin(), path_cache.end());
-            path_cache.clear();
         } else {
-            path_cache.clear();
+            safe_state_ids.insert(path_cache.begin(), path_cache.end());
         }
+        path_cache.clear();
+    }
+
+    const auto propagated = envelope.propagate_unsafety();
+    const auto num_on_paths = unsafe_state_ids.size();
+    unsafe_state_ids.insert(propagated.begin(), propagated.end());
+    for (const auto id: unsafe_state_ids) { safe_state_ids.erase(id); }
+    PLAJA_LOG("Propagation labeled " + std::to_string(unsafe_state_ids.size() - num_on_paths) +
+              " additional unsafe states (" + std::to_string(envelope.num_states()) + " explored states).")
+    if (per_iteration_stats) {
+        per_iteration_stats->set_propagated_unsafe_states(unsafe_state_ids.size() - num_on_paths);
     }
     return unsafe_state_ids;
 }
@@ -89,52 +110,51 @@ std::unordered_set<StateID_type> UnsafePathIdentifier::identify_unsafe_paths() {
 /**
  * Simulates policy execution from a given state until a terminal state is reached.
  *
- * @param start_state state to begin policy execution from.
+ * @param start_id ID of the state to begin policy execution from.
  *
  * @return true if unsafe state is reached, false otherwise.
  */
-bool UnsafePathIdentifier::execute_policy(State& start_state) {
-    std::unique_ptr<State> current_state = start_state.to_ptr(); // copy
+bool UnsafePathIdentifier::execute_policy(const StateID_type start_id) {
+    StateID_type current_id = start_id;
 
-    PLAJA_FLOG_IF(log_path, start_log)
-    PLAJA_FLOG_IF(log_path, start_state.to_str())
+    if (trajectory_log) { trajectory_log->start(start_id, sim_env.get_state(start_id)); }
 
-    while (not is_terminal(*current_state)) {
-        current_state = simulate_until_choice(*current_state);
+    while (not is_terminal(current_id)) {
+        current_id = simulate_until_choice(current_id);
 
-        if (not current_state) {
-            PLAJA_FLOG_IF(log_path, deadend_log)
+        if (current_id == no_state) {
+            // no-op if the outcome was already logged during the simulation.
+            log_end(StartGenerator::TrajectoryLog::Outcome::DeadEnd);
             return false;
         } // dead-end reached -> safe.
-        set_current_state(*current_state); // for cycle detection
-        if (is_unsafe(*current_state)) {
-            PLAJA_FLOG_IF(log_path, unsafety_log)
+        const auto current_state = sim_env.get_state(current_id);
+        set_current_state(current_id); // for cycle detection
+        if (is_unsafe(current_state)) {
+            envelope.mark_unsafe(current_id);
+            log_end(StartGenerator::TrajectoryLog::Outcome::Unsafe);
             return true;
         }
 
-        const auto action_label = policy.evaluate(*current_state);
-        // std::cout << "action: " << action_label << std::endl;
-        // auto action_id = ModelInformation::action_label_to_id(action_label);
-        // auto action_str = get_model().get_action_name(action_id);
-        // std::cout << action_str << std::endl;
+        const auto action_label = policy.evaluate(current_state);
+        current_id = sample_successor(current_id, action_label);
 
-        current_state = sample_successor(*current_state, action_label);
-
-        PLAJA_FLOG_IF(log_path, action_log(action_label))
-        PLAJA_FLOG_IF(log_path, current_state->to_str())
+        if (current_id == no_state) {
+            log_end(StartGenerator::TrajectoryLog::Outcome::DeadEnd);
+            return false;
+        } // dead-end reached.
 
-        if (not current_state) { return false; } // dead-end reached.
+        log_step(action_label, current_id);
 
-        set_next_state(*current_state);
+        set_next_state(current_id);
         if (not cache_and_check_cycle(action_label) and terminate_on_cycles) {
-            PLAJA_FLOG_IF(log_path, cycle_log)
+            log_end(StartGenerator::TrajectoryLog::Outcome::Cycle);
             return false;
         } // cycle detected.
 
-        path_cache.insert(current_state->get_id());
+        path_cache.insert(current_id);
         set_next_to_current_state();
         if (path_cache.size() >= path_length_limit) {
-            PLAJA_FLOG_IF(log_path, cycle_log)
+            log_end(StartGenerator::TrajectoryLog::Outcome::LengthLimit);
             return false;
         } // limit path length
     }
@@ -144,80 +164,95 @@ bool UnsafePathIdentifier::execute_policy(State& start_state) {
 /**
  * @brief Expands states until a state with multiple actions is found, or a state cannot be expanded (dead-end/unsafe).
  *
- * @param state to begin simulation from.
+ * @param state_id ID of the state to begin simulation from.
  *
- * @return state with multiple actions, an unsafe state, or nullptr for terminal states.
+ * @return ID of a state with multiple actions, of an unsafe state, or no_state for terminal states.
  */
-std::unique_ptr<State> UnsafePathIdentifier::simulate_until_choice(const State& state) {
-    std::unique_ptr<State> current_state = state.to_ptr(); // creates duplicate
+StateID_type UnsafePathIdentifier::simulate_until_choice(const StateID_type state_id) {
+    StateID_type current_id = state_id;
 
     // simulate until next choice point
-    auto cachedApplicableActions = sim_env.extract_applicable_actions(*current_state, true);
-    while (cachedApplicableActions.size() <= 1) {
+    applicable_actions = successor_cache.applicable_actions(current_id);
+    while (applicable_actions->size() <= 1) {
 
-        if (cachedApplicableActions.empty()) { return nullptr; }
+        if (applicable_actions->empty()) { return no_state; }
 
         // step:
-        const ActionLabel_type next_action = cachedApplicableActions[0];
-        current_state = sample_successor(*current_state, next_action);
+        const ActionLabel_type next_action = applicable_actions->front();
+        current_id = sample_successor(current_id, next_action);
+        if (current_id == no_state) { return no_state; }
+        const auto current_state = sim_env.get_state(current_id);
 
-        PLAJA_FLOG_IF(log_path, action_log(next_action))
-        PLAJA_FLOG_IF(log_path, current_state->to_str())
+        log_step(next_action, current_id);
 
-        set_next_state(*current_state);
+        set_next_state(current_id);
         if (not cache_and_check_cycle(next_action) and terminate_on_cycles) {
-            PLAJA_FLOG_IF(log_path, cycle_log)
-            return nullptr; // cycle detected.
+            log_end(StartGenerator::TrajectoryLog::Outcome::Cycle);
+            return no_state; // cycle detected.
         }
 
-        if (is_unsafe(*current_state)) {
-            PLAJA_FLOG_IF(log_path, unsafety_log)
-            return current_state;
+        if (is_unsafe(current_state)) {
+            envelope.mark_unsafe(current_id);
+            log_end(StartGenerator::TrajectoryLog::Outcome::Unsafe);
+            return current_id;
         }
 
-        path_cache.insert(current_state->get_id());
+        path_cache.insert(current_id);
 
         // applicable actions for next iteration
-        cachedApplicableActions = sim_env.extract_applicable_actions(*current_state, true);
+        applicable_actions = successor_cache.applicable_actions(current_id);
         set_next_to_current_state();
         if (path_cache.size() >= path_length_limit) {
-            PLAJA_FLOG_IF(log_path, cycle_log)
-            return nullptr;
+            log_end(StartGenerator::TrajectoryLog::Outcome::LengthLimit);
+            return no_state;
         }
     }
-    return current_state;
+    return current_id;
 }
 
 /**
  * @brief samples a successor based on transition probabilities or based on distance function.
  *
  * In case of multiple successors, and policy_run_sampling is enabled will perform policy run sampling with some probability.
+ * The successors computed here are reused for the sampling, so the step does not generate successors twice.
  *
- * @return successor state in s[a].
+ * @return ID of the successor state in s[a], or no_state if the action is not applicable.
  */
-std::unique_ptr<State> UnsafePathIdentifier::sample_successor(const State& state, ActionLabel_type action_label) {
-    const auto p = PLAJA_GLOBAL::rng->prob();
-    auto successor_ids = sim_env.compute_successors(state, action_label);
-    if (successor_ids.size() > 1 and p < sampling_probability and !timer->is_almost_expired(1)) {
-        auto [successor,path] = policy_run_sampler->sample_run(successor_ids);
-        for (auto s :path ) {
-            path_cache.insert(s);
-        }
-        return std::move(successor);
+StateID_type UnsafePathIdentifier::sample_successor(const StateID_type state_id, ActionLabel_type action_label) {
+    target_by_sampled_run = false;
+    const auto successors = successor_cache.successors(state_id, action_label);
+    if (successors->empty()) { return no_state; }
+    ++num_steps;
+    if (successors->size() == 1) { return successors->ids.front(); }
+    const auto p = trajectory_rng.prob();
+    if (policy_run_sampler and p < sampling_probability and deadline.remaining() > 1) {
+        auto [successor, path] = policy_run_sampler->sample_run(successors->ids, trajectory_rng);
+        path_cache.insert(path.begin(), path.end());
+        add_sampled_path(state_id, path, successor);
+        target_by_sampled_run = true;
+        return successor;
     }
-    return sim_env.compute_successor_if_applicable(state, action_label);
+    return successors->sample(trajectory_rng);
 }
 
 /// @return true if state has no successor states.
-bool UnsafePathIdentifier::is_terminal(const State& state) {
-    bool dead_end = sim_env.extract_applicable_actions(state, true).empty();
+bool UnsafePathIdentifier::is_terminal(const StateID_type state_id) {
+    bool dead_end = successor_cache.applicable_actions(state_id)->empty();
     if (dead_end) {
         search_stats.inc_attr_unsigned(PLAJA::StatsUnsigned::DEAD_ENDS);
-        PLAJA_FLOG_IF(log_path, deadend_log)
+        log_end(StartGenerator::TrajectoryLog::Outcome::DeadEnd);
     }
     return dead_end;
 }
 
+void UnsafePathIdentifier::log_step(const ActionLabel_type action, const StateID_type state_id) {
+    if (trajectory_log) { trajectory_log->step(action, state_id, sim_env.get_state(state_id)); }
+}
+
+void UnsafePathIdentifier::log_end(const StartGenerator::TrajectoryLog::Outcome outcome) {
+    if (trajectory_log) { trajectory_log->end(outcome); }
+}
+
 bool UnsafePathIdentifier::is_unsafe(const State& state) const {
     PUSH_LAP_IF(per_iteration_stats, PLAJA::StatsDouble::UNSAFETY_EVAL);
     bool result = unsafety_condition.evaluate_integer(state);
@@ -225,27 +260,51 @@ bool UnsafePathIdentifier::is_unsafe(const State& state) const {
     return result;
 }
 
-void UnsafePathIdentifier::set_current_state(const State& state) {
-    source = state.get_id();
-    target = -1;
+void UnsafePathIdentifier::set_current_state(const StateID_type state_id) {
+    source = state_id;
+    target = no_state;
 }
 
-void UnsafePathIdentifier::set_next_state(const State& state) { target = state.get_id(); }
+void UnsafePathIdentifier::set_next_state(const StateID_type state_id) { target = state_id; }
 
 void UnsafePathIdentifier::set_next_to_current_state() {
-    assert(target != -1);
+    assert(target != no_state);
     source = target;
-    target = -1;
+    target = no_state;
 }
 
 /**
  * Caches transition and checks if cycle is detected.
+ * The envelope only receives model transitions; those of a sampled run were added along its path.
  *
  * @return false if cycle detected.
  */
 bool UnsafePathIdentifier::cache_and_check_cycle(const ActionLabel_type& action_label) {
-    assert(target != -1 && source != -1);
+    assert(target != no_state && source != no_state);
     const bool inserted = transition_cache.insert({source, action_label, target}).second;
-    if (not inserted) { search_stats.inc_attr_unsigned(PLAJA::StatsUnsigned::CYCLES); }
+    if (not inserted) {
+        search_stats.inc_attr_unsigned(PLAJA::StatsUnsigned::CYCLES);
+    } else if (not target_by_sampled_run) {
+        envelope.add_transition(source, target);
+    }
     return inserted;
 }
+
+/**
+ * Adds the transitions of a path sampled by policy-run sampling to the envelope.
+ *
+ * @param state_id state the sampled run starts from.
+ * @param path sampled run from leaf (or the parent of the unsafe leaf) back to the first successor.
+ * @param successor leaf of the sampled run.
+ */
+void UnsafePathIdentifier::add_sampled_path(
+    const StateID_type state_id,
+    const std::vector<StateID_type>& path,
+    const StateID_type successor) {
+    StateID_type previous = state_id;
+    for (auto it = path.rbegin(); it != path.rend(); ++it) {
+        envelope.add_transition(previous, *it);
+        previous = *it;
+    }
+    if (previous != successor) { envelope.add_transition(previous, successor); }
+}
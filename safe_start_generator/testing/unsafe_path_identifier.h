@@ -4,9 +4,15 @@
 
 #ifndef UNSAFE_PATH_IDENTIFIER_H
 #define UNSAFE_PATH_IDENTIFIER_H
-#include "../../search/non_prob_search/initial_states_enumerator.h"
 #include "../../successor_generation/simulation_environment.h"
+#include "../deadline.h"
+#include "policy_cache.h"
+#include "policy_envelope.h"
 #include "policy_run_sampling.h"
+#include "rng_stream.h"
+#include "start_sampler.h"
+#include "successor_cache.h"
+#include "trajectory_log.h"
 #include "transition_set.h"
 
 class StartGenerationStatistics;
@@ -18,12 +24,16 @@ class UnsafePathIdentifier {
 public:
     UnsafePathIdentifier(
         const PLAJA::Configuration& config,
-        int time_limit,
+        const StartGenerator::Deadline& deadline,
         SimulationEnvironment& simulation_environment,
-        const Policy& policy,
+        StartGenerator::SuccessorCache& successor_cache,
+        StartGenerator::PolicyCache& policy,
         const Expression& start_condition,
         const Expression& unsafety_condition,
-        InitialStatesEnumerator* enumerator,
+        StartGenerator::StartSampler* start_sampler,
+        const StartGenerator::RngStreamFactory& rng_streams,
+        StartGenerator::PolicyEnvelope& envelope,
+        StartGenerator::TrajectoryLog* trajectory_log,
         PLAJA::StatsBase& search_statistics,
         StartGenerationStatistics* perIterStats,
         bool terminateCyclesFlag,
@@ -33,18 +43,34 @@ public:
 
     std::unordered_set<StateID_type> identify_unsafe_paths();
 
+    /// @return states of trajectories that did not reach the unsafety condition, and cannot reach it as far as known.
+    [[nodiscard]] const std::unordered_set<StateID_type>& get_safe_state_ids() const { return safe_state_ids; }
+
+    /// @return number of simulated transitions so far.
+    [[nodiscard]] std::size_t get_num_steps() const { return num_steps; }
+
 private:
     const Expression& start_condition;
     const Expression& unsafety_condition;
-    InitialStatesEnumerator* start_sampler;
+    StartGenerator::StartSampler* start_sampler;
     SimulationEnvironment& sim_env;
-    const Policy& policy;
+    StartGenerator::SuccessorCache& successor_cache; // memoized applicable actions and successors.
+    StartGenerator::SuccessorCache::Actions applicable_actions; // of the current state.
+    StartGenerator::PolicyCache& policy; // decisions memoized across testing phases.
     const int path_length_limit = 1000;
-    std::unique_ptr<Timer> timer;
+    const StartGenerator::Deadline deadline; // of this testing phase.
+
+    /* Randomness: the k-th trajectory of the phase draws from stream k, so results only depend on the seed. */
+    const StartGenerator::RngStreamFactory rng_streams;
+    uint64_t num_trajectories = 0; // keys the stream of the next trajectory.
+    StartGenerator::RngStream trajectory_rng { 0, 0 };
 
     bool unsafe_path_found = false;
+    std::size_t num_steps = 0;
     std::unordered_set<StateID_type> unsafe_state_ids;
+    std::unordered_set<StateID_type> safe_state_ids;
     std::unordered_set<StateID_type> path_cache; // excluding unsafe states.
+    StartGenerator::PolicyEnvelope& envelope;     // explored transitions, used to propagate unsafety backwards.
 
     /* Policy-run sampling */
     double sampling_probability = 0;
@@ -52,34 +78,35 @@ private:
 
     /* Cycle detection */
     bool terminate_on_cycles;
-    StateID_type source = -1;
-    StateID_type target = -1;
+    StateID_type source = no_state;
+    StateID_type target = no_state;
+    bool target_by_sampled_run = false; // target is the leaf of a policy run, not a successor of source.
     StartGenerator::TransitionSet transition_cache;
 
     PLAJA::StatsBase& search_stats;
     StartGenerationStatistics* per_iteration_stats = nullptr;
 
-    bool log_path = false; // flag to enable dumping of execution path.
-    std::string start_log = "====== EXECUTION START ======";
-    std::string deadend_log = "====== DEAD END ======\n";
-    std::string cycle_log = "====== CYCLE ======\n";
-    std::string unsafety_log = "====== UNSAFE ======\n";
-    std::string action_log(ActionLabel_type action) { return "action: " + std::to_string(action); }
-
+    StartGenerator::TrajectoryLog* trajectory_log; // optional, records every trajectory and its outcome.
+    void log_step(ActionLabel_type action, StateID_type state_id);
+    void log_end(StartGenerator::TrajectoryLog::Outcome outcome);
 
     /* Policy Execution*/
-    std::unique_ptr<State> sample_successor(const State& state, ActionLabel_type action_label);
-    std::unique_ptr<State> simulate_until_choice(const State& state);
-    bool execute_policy(State& start_state);
-
-    bool is_terminal(const State& state);
+    // States are passed around by ID and accessed through views into the state registry of `sim_env`,
+    // so a trajectory does not allocate state copies.
+    static constexpr StateID_type no_state = -1;
+    StateID_type sample_successor(StateID_type state_id, ActionLabel_type action_label);
+    StateID_type simulate_until_choice(StateID_type state_id);
+    bool execute_policy(StateID_type start_id);
+
+    bool is_terminal(StateID_type state_id);
     bool is_unsafe(const State& state) const;
 
     /* Cycle detection */
-    void set_current_state(const State& state);
-    void set_next_state(const State& state);
+    void set_current_state(StateID_type state_id);
+    void set_next_state(StateID_type state_id);
     void set_next_to_current_state();
     bool cache_and_check_cycle(const ActionLabel_type& action_label);
+    void add_sampled_path(StateID_type state_id, const std::vector<StateID_type>& path, StateID_type successor);
 };
 
 #endif //UNSAFE_PATH_IDENTIFIER_H
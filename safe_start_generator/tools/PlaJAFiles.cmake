@@ -0,0 +1,14 @@
+# Offline tools for artifacts written by the safe start generator.
+# Kept apart from SAFE_START_GENERATOR_SOURCES; the tools do not depend on PlaJA.
+set(SAFE_START_GENERATOR_TOOLS_SOURCES
+        ${CMAKE_CURRENT_LIST_DIR}/trajectory_log_dump.cpp
+        ${CMAKE_CURRENT_LIST_DIR}/../testing/trajectory_log_reader.cpp
+        ${CMAKE_CURRENT_LIST_DIR}/../testing/trajectory_log_reader.h
+        ${CMAKE_CURRENT_LIST_DIR}/../testing/trajectory_log_format.h
+)
+
+option(BUILD_SAFE_START_TOOLS "Build the offline tools of the safe start generator (e.g., trajectory_log_dump)." OFF)
+
+if (BUILD_SAFE_START_TOOLS)
+    add_executable(trajectory_log_dump ${SAFE_START_GENERATOR_TOOLS_SOURCES})
+endif ()
@@ -0,0 +1,116 @@
+//
+// Created by Daniel Sherbakov in 2025.
+//
+
+#include "../testing/trajectory_log_reader.h"
+
+#include <cstdlib>
+#include <iostream>
+#include <map>
+#include <optional>
+#include <string>
+
+/**
+ * Dumps a binary trajectory log as text.
+ *
+ * usage: trajectory_log_dump <log> [--summary] [--outcome unsafe|dead_end|cycle|length_limit|open]
+ *                                  [--trajectory <index>] [--state <id>]
+ *
+ * --state keeps trajectories that visit the given state id.
+ */
+namespace {
+
+    struct Filter {
+        std::optional<std::string> outcome;
+        std::optional<std::size_t> trajectory;
+        std::optional<int32_t> state;
+    };
+
+    std::string outcome_of(const StartGenerator::TrajectoryLogReader::Trajectory& trajectory) {
+        return trajectory.outcome ? StartGenerator::TrajectoryLogFormat::outcome_to_string(*trajectory.outcome) : "open";
+    }
+
+    bool matches(const Filter& filter, const StartGenerator::TrajectoryLogReader::Trajectory& trajectory) {
+        if (filter.trajectory and *filter.trajectory != trajectory.index) { return false; }
+        if (filter.outcome and *filter.outcome != outcome_of(trajectory)) { return false; }
+        if (filter.state) {
+            if (trajectory.start_id == *filter.state) { return true; }
+            for (const auto& step: trajectory.steps) {
+                if (step.state_id == *filter.state) { return true; }
+            }
+            return false;
+        }
+        return true;
+    }
+
+    void print_valuation(const std::vector<int32_t>& valuation) {
+        std::cout << "[";
+        for (std::size_t i = 0; i < valuation.size(); ++i) { std::cout << (i ? ", " : "") << valuation[i]; }
+        std::cout << "]";
+    }
+
+    void print(const StartGenerator::TrajectoryLogReader::Trajectory& trajectory) {
+        std::cout << "trajectory " << trajectory.index << " (" << outcome_of(trajectory) << ", " << trajectory.steps.size() << " steps)" << std::endl;
+        std::cout << "  start state " << trajectory.start_id << " ";
+        print_valuation(trajectory.start_valuation);
+        std::cout << std::endl;
+        for (const auto& step: trajectory.steps) {
+            std::cout << "  action " << step.action << " -> state " << step.state_id << " ";
+            print_valuation(step.valuation);
+            std::cout << std::endl;
+        }
+    }
+
+    [[noreturn]] void usage() {
+        std::cerr << "usage: trajectory_log_dump <log> [--summary] [--outcome unsafe|dead_end|cycle|length_limit|open] "
+                     "[--trajectory <index>] [--state <id>]"
+                  << std::endl;
+        std::exit(EXIT_FAILURE);
+    }
+
+} // namespace
+
+int main(int argc, char** argv) {
+    if (argc < 2) { usage(); }
+    const std::string file_name = argv[1];
+    Filter filter;
+    bool summary = false;
+    for (int i = 2; i < argc; ++i) {
+        const std::string arg = argv[i];
+        if (arg == "--summary") {
+            summary = true;
+        } else if (i + 1 < argc and arg == "--outcome") {
+            filter.outcome = argv[++i];
+        } else if (i + 1 < argc and arg == "--trajectory") {
+            filter.trajectory = std::stoul(argv[++i]);
+        } else if (i + 1 < argc and arg == "--state") {
+            filter.state = std::stoi(argv[++i]);
+        } else {
+            usage();
+        }
+    }
+
+    try {
+        StartGenerator::TrajectoryLogReader reader(file_name);
+        StartGenerator::TrajectoryLogReader::Trajectory trajectory;
+        std::map<std::string, std::size_t> outcomes;
+        std::size_t num_matching = 0;
+        std::size_t num_steps = 0;
+        while (reader.next(trajectory)) {
+            if (not matches(filter, trajectory)) { continue; }
+            ++num_matching;
+            ++outcomes[outcome_of(trajectory)];
+            num_steps += trajectory.steps.size();
+            if (not summary) { print(trajectory); }
+        }
+        if (summary) {
+            std::cout << "trajectories: " << num_matching << std::endl;
+            std::cout << "steps: " << num_steps << std::endl;
+            for (const auto& [outcome, count]: outcomes) { std::cout << outcome << ": " << count << std::endl; }
+        }
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
@@ -8,4 +8,10 @@ set(STRENGTHENING_METHODS_SOURCES
         ${CMAKE_CURRENT_LIST_DIR}/verification_types.h
         ${CMAKE_CURRENT_LIST_DIR}/start_condition_strengthening.cpp
         ${CMAKE_CURRENT_LIST_DIR}/start_condition_strengthening.h
+        ${CMAKE_CURRENT_LIST_DIR}/portfolio_verification.cpp
+        ${CMAKE_CURRENT_LIST_DIR}/portfolio_verification.h
+        ${CMAKE_CURRENT_LIST_DIR}/input_splitting.cpp
+        ${CMAKE_CURRENT_LIST_DIR}/input_splitting.h
+        ${CMAKE_CURRENT_LIST_DIR}/solver_time_limits.cpp
+        ${CMAKE_CURRENT_LIST_DIR}/solver_time_limits.h
 )
\ No newline at end of file
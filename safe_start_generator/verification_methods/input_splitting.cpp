@@ -0,0 +1,261 @@
+//
+// Created by Daniel Sherbakov in 2025.
+//
+
+#include "input_splitting.h"
+
+#include "../../../globals.h"
+#include "../../../parser/ast/expression/binary_op_expression.h"
+#include "../../../parser/ast/expression/integer_value_expression.h"
+#include "../../../parser/ast/expression/special_cases/nary_expression.h"
+#include "../../../parser/ast/model.h"
+#include "../../../parser/ast/variable_declaration.h"
+#include "../../../utils/utils.h"
+#include "../../factories/configuration.h"
+#include "../../information/model_information.h"
+#include "../../smt_nn/model/model_marabou.h"
+#include "../../smt_nn/solver/smt_solver_marabou.h"
+#include "../../smt_nn/solver/solution_marabou.h"
+#include "solver_time_limits.h"
+
+#include <algorithm>
+#include <chrono>
+#include <deque>
+#include <iterator>
+#include <thread>
+
+namespace VerificationMethods {
+
+    InputSplitting::InputSplitting(
+        const PLAJA::Configuration& config,
+        ModelMarabou& model_marabou,
+        const std::size_t num_solvers,
+        const double part_timeout):
+        model_marabou(model_marabou),
+        model(*PLAJA_GLOBAL::currentModel),
+        part_timeout(part_timeout) {
+        PLAJA_ASSERT(num_solvers > 0)
+        solvers.reserve(num_solvers);
+        for (std::size_t i = 0; i < num_solvers; ++i) {
+            solvers.push_back(PLAJA_UTILS::cast_unique<MARABOU_IN_PLAJA::SMTSolver>(model_marabou.init_solver(config, 1)));
+            model_marabou.add_nn_to_query(solvers.back()->_query(), 0); // Encode policy.
+        }
+    }
+
+    InputSplitting::~InputSplitting() = default;
+
+    void InputSplitting::push(const Expression& start, const Expression& unsafety) {
+        for (auto& solver: solvers) {
+            solver->push();
+            model_marabou.add_to_solver(*solver, start, 0);
+            model_marabou.add_to_solver(*solver, unsafety, 1);
+        }
+    }
+
+    void InputSplitting::pop() {
+        for (auto& solver: solvers) { solver->pop(); }
+    }
+
+    void InputSplitting::add_output_interface(const ActionLabel_type action_label) {
+        for (auto& solver: solvers) { model_marabou.add_output_interface(*solver, action_label, 0); }
+    }
+
+    /**
+     * The parts are checked in waves of one part per solver. Encoding happens on the calling thread, only the checks
+     * run in parallel, each on its own solver. A check that reaches the per-part timeout is aborted and its part is
+     * replaced by its halves, which are queued behind the remaining parts of this query.
+     */
+    MARABOU_IN_PLAJA::SMTSolver* InputSplitting::exists_policy_transition(
+        const ActionOpID_type action_op_id,
+        const UpdateIndex_type update_index,
+        const bool do_locs,
+        const StartGenerator::Deadline& deadline) {
+        auto& partition = get_partition(action_op_id, update_index);
+        merge_fast_parts(partition);
+        std::deque<Part> queue(std::make_move_iterator(partition.begin()), std::make_move_iterator(partition.end()));
+        partition.clear(); // refilled with the parts as checked, the partition of the next runs.
+        MARABOU_IN_PLAJA::SMTSolver* witness = nullptr;
+
+        while (not queue.empty() and not witness and not deadline.is_expired()) {
+            const auto wave = std::min(solvers.size(), queue.size());
+            std::vector<Part> parts;
+            std::vector<std::size_t> split_dimensions;
+            for (std::size_t i = 0; i < wave; ++i) {
+                parts.push_back(std::move(queue.front()));
+                queue.pop_front();
+                split_dimensions.push_back(get_split_dimension(parts.back()));
+
+                auto& solver = *solvers[i];
+                solver.push();
+                model_marabou.add_action_op(solver, action_op_id, update_index, do_locs, true, 0);
+                const auto box = to_expression(parts.back());
+                if (box) { model_marabou.add_to_solver(solver, *box, 0); }
+            }
+
+            std::vector<CheckResult> results(wave, CheckResult::Unknown);
+            std::vector<double> seconds(wave, 0);
+            auto check = [&](const std::size_t i) {
+                // a part that cannot be split any further is only bounded by the deadline.
+                const bool splittable = split_dimensions[i] < parts[i].bounds.size();
+                const double limit = splittable ? std::min(part_timeout, deadline.remaining()) : deadline.remaining();
+                const auto begin = std::chrono::steady_clock::now();
+                results[i] = check_within(*solvers[i], limit);
+                seconds[i] = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+            };
+            if (wave == 1) {
+                check(0);
+            } else {
+                std::vector<std::thread> threads;
+                threads.reserve(wave);
+                for (std::size_t i = 0; i < wave; ++i) { threads.emplace_back(check, i); }
+                for (auto& thread: threads) { thread.join(); }
+            }
+
+            for (std::size_t i = 0; i < wave; ++i) {
+                solvers[i]->pop(); // the solution is kept until the next check.
+                if (results[i] == CheckResult::Sat and not witness) { witness = solvers[i].get(); }
+                if (results[i] == CheckResult::Unknown and split_dimensions[i] < parts[i].bounds.size() and
+                    not deadline.is_expired()) {
+                    auto [lower, upper] = split(std::move(parts[i]), split_dimensions[i]);
+                    queue.push_back(std::move(lower));
+                    queue.push_back(std::move(upper));
+                } else {
+                    parts[i].fast = results[i] != CheckResult::Unknown and seconds[i] < part_timeout * fast_share;
+                    partition.push_back(std::move(parts[i]));
+                }
+            }
+        }
+
+        // parts not checked any more, after a satisfiable part or at the deadline.
+        std::move(queue.begin(), queue.end(), std::back_inserter(partition));
+        return witness;
+    }
+
+    std::size_t InputSplitting::num_parts() const {
+        std::size_t num = 0;
+        for (const auto& [query, partition]: partitions) { num += partition.size(); }
+        return num;
+    }
+
+    std::vector<InputSplitting::Part>& InputSplitting::get_partition(
+        const ActionOpID_type action_op_id,
+        const UpdateIndex_type update_index) {
+        auto [it, inserted] = partitions.try_emplace({ action_op_id, update_index });
+        if (inserted) {
+            // a single part covering the whole domain.
+            const auto& model_info = model.get_model_information();
+            Part domain;
+            for (int state_index = 1; state_index <= model.get_number_variables(); ++state_index) {
+                domain.bounds.emplace_back(
+                    model_info.get_lower_bound_int(state_index),
+                    model_info.get_upper_bound_int(state_index));
+            }
+            it->second.push_back(std::move(domain));
+        }
+        return it->second;
+    }
+
+    /**
+     * The widest dimension relative to its domain is the one the part knows least about; this is the largest-interval
+     * heuristic of Marabou's own divide-and-conquer mode.
+     */
+    std::size_t InputSplitting::get_split_dimension(const Part& part) const {
+        if (part.depth >= max_depth) { return part.bounds.size(); }
+        const auto& model_info = model.get_model_information();
+        std::size_t widest = part.bounds.size();
+        double widest_share = 0;
+        for (std::size_t var = 0; var < part.bounds.size(); ++var) {
+            const auto [lb, ub] = part.bounds[var];
+            if (lb == ub) { continue; }
+            const double domain = model_info.get_upper_bound_int(var + 1) - model_info.get_lower_bound_int(var + 1);
+            const double share = (ub - lb) / domain;
+            if (share > widest_share) {
+                widest = var;
+                widest_share = share;
+            }
+        }
+        return widest;
+    }
+
+    std::pair<InputSplitting::Part, InputSplitting::Part> InputSplitting::split(
+        Part part,
+        const std::size_t dimension) {
+        const auto [lb, ub] = part.bounds[dimension];
+        const int mid = lb + (ub - lb) / 2;
+        Part lower = part;
+        Part upper = std::move(part);
+        lower.bounds[dimension].second = mid;
+        upper.bounds[dimension].first = mid + 1;
+        lower.depth = upper.depth = lower.depth + 1;
+        return { std::move(lower), std::move(upper) };
+    }
+
+    /**
+     * Two parts that coincide in all but one dimension, in which they are adjacent, form a box together, so the merged
+     * part covers exactly the same states. Whether they stem from the same split does not matter.
+     */
+    void InputSplitting::merge_fast_parts(std::vector<Part>& partition) {
+        for (std::size_t i = 0; i < partition.size(); ++i) {
+            if (not partition[i].fast) { continue; }
+            for (std::size_t j = i + 1; j < partition.size(); ++j) {
+                if (not partition[j].fast) { continue; }
+                const auto dimension = get_merge_dimension(partition[i], partition[j]);
+                if (not dimension) { continue; }
+                auto& merged = partition[i];
+                auto& bounds = merged.bounds[*dimension];
+                bounds.first = std::min(bounds.first, partition[j].bounds[*dimension].first);
+                bounds.second = std::max(bounds.second, partition[j].bounds[*dimension].second);
+                const auto depth = std::max(merged.depth, partition[j].depth);
+                merged.depth = depth > 0 ? depth - 1 : 0;
+                merged.fast = false; // not checked as a whole yet.
+                partition[j] = std::move(partition.back());
+                partition.pop_back();
+                break;
+            }
+        }
+    }
+
+    std::optional<std::size_t> InputSplitting::get_merge_dimension(const Part& part, const Part& other) {
+        std::optional<std::size_t> dimension;
+        for (std::size_t var = 0; var < part.bounds.size(); ++var) {
+            if (part.bounds[var] == other.bounds[var]) { continue; }
+            if (dimension) { return std::nullopt; } // differ in a second dimension.
+            const auto [lb, ub] = part.bounds[var];
+            const auto [other_lb, other_ub] = other.bounds[var];
+            if (ub + 1 != other_lb and other_ub + 1 != lb) { return std::nullopt; }
+            dimension = var;
+        }
+        return dimension;
+    }
+
+    std::unique_ptr<Expression> InputSplitting::to_expression(const Part& part) const {
+        const auto& model_info = model.get_model_information();
+        auto box = std::make_unique<NaryExpression>(BinaryOpExpression::AND);
+        bool is_domain = true;
+        for (std::size_t var = 0; var < part.bounds.size(); ++var) {
+            const auto [lb, ub] = part.bounds[var];
+            const auto var_index = static_cast<VariableIndex_type>(var);
+            const bool lower_tight = lb > model_info.get_lower_bound_int(var + 1);
+            const bool upper_tight = ub < model_info.get_upper_bound_int(var + 1);
+            if (not lower_tight and not upper_tight) { continue; }
+            is_domain = false;
+
+            auto var_expr = model.gen_var_expr(var_index, model.get_variable(var_index));
+            if (lower_tight) {
+                auto lower_bound = std::make_unique<BinaryOpExpression>(BinaryOpExpression::GE);
+                lower_bound->set_left(var_expr->deepCopy_Exp());
+                lower_bound->set_right(std::make_unique<IntegerValueExpression>(lb));
+                box->add_sub(std::move(lower_bound));
+            }
+            if (upper_tight) {
+                auto upper_bound = std::make_unique<BinaryOpExpression>(BinaryOpExpression::LE);
+                upper_bound->set_left(std::move(var_expr));
+                upper_bound->set_right(std::make_unique<IntegerValueExpression>(ub));
+                box->add_sub(std::move(upper_bound));
+            }
+        }
+        if (is_domain) { return nullptr; }
+        return box;
+    }
+
+} // namespace VerificationMethods
@@ -0,0 +1,102 @@
+//
+// Created by Daniel Sherbakov in 2025.
+//
+
+#ifndef INPUT_SPLITTING_H
+#define INPUT_SPLITTING_H
+
+#include "../../../utils/default_constructors.h"
+#include "../../smt_nn/forward_smt_nn.h"
+#include "../../using_search.h"
+#include "../deadline.h"
+
+#include <map>
+#include <memory>
+#include <optional>
+#include <utility>
+#include <vector>
+
+class Expression;
+class Model;
+class ModelMarabou;
+namespace PLAJA {
+    class Configuration;
+}
+
+namespace VerificationMethods {
+
+    /**
+     * @brief Solves the policy queries of `InvariantStrengthening` split into sub-boxes of the input region.
+     *
+     * Each (operator, update) query keeps a partition of the state variable domains. The parts are encoded on a pool
+     * of Marabou solvers and checked in parallel, one part per solver at a time; the first satisfiable part ends the
+     * query, and the remaining parts are not checked.
+     *
+     * A check is aborted once it reaches the per-part timeout, and its part is replaced by two halves along its widest
+     * dimension, which are checked later in the same run. The partition as checked is kept for the next verification
+     * run, which issues the same queries against a strengthened start condition. Before that run, two adjacent parts
+     * whose checks both concluded fast are merged again, one level per run, since the strengthened start condition
+     * usually makes the query easier. Easy queries thus remain a single part, hard ones are split as far as needed.
+     */
+    class InputSplitting {
+    public:
+        InputSplitting(
+            const PLAJA::Configuration& config,
+            ModelMarabou& model_marabou,
+            std::size_t num_solvers,
+            double part_timeout);
+        ~InputSplitting();
+        DELETE_CONSTRUCTOR(InputSplitting)
+
+        /// adds the conditions shared by all queries of a verification run, removed again by `pop`.
+        void push(const Expression& start, const Expression& unsafety);
+        void pop();
+        void add_output_interface(ActionLabel_type action_label);
+
+        /**
+         * @brief checks for a policy transition of the update, part by part.
+         * Parts are not checked any more once the deadline expired.
+         * @return the solver holding the solution of a satisfiable part, nullptr if no part is satisfiable.
+         */
+        MARABOU_IN_PLAJA::SMTSolver* exists_policy_transition(
+            ActionOpID_type action_op_id,
+            UpdateIndex_type update_index,
+            bool do_locs,
+            const StartGenerator::Deadline& deadline);
+
+        /// @return number of parts over all queries.
+        [[nodiscard]] std::size_t num_parts() const;
+
+    private:
+        /// splits of a part, limits a query to 2^max_depth parts.
+        static constexpr std::size_t max_depth = 8;
+        /// share of the per-part timeout below which a conclusive check counts as fast.
+        static constexpr double fast_share = 0.25;
+
+        struct Part {
+            std::vector<std::pair<int, int>> bounds; // [lower,upper] per state variable, excluding the location.
+            std::size_t depth = 0;
+            bool fast = false; // its last check concluded within fast_share of the timeout.
+        };
+
+        ModelMarabou& model_marabou;
+        const Model& model;
+        const double part_timeout; // in seconds.
+        std::vector<std::unique_ptr<MARABOU_IN_PLAJA::SMTSolver>> solvers;
+        std::map<std::pair<ActionOpID_type, UpdateIndex_type>, std::vector<Part>> partitions;
+
+        std::vector<Part>& get_partition(ActionOpID_type action_op_id, UpdateIndex_type update_index);
+        /// @return dimension to split the part along, the number of dimensions if it cannot be split.
+        [[nodiscard]] std::size_t get_split_dimension(const Part& part) const;
+        [[nodiscard]] static std::pair<Part, Part> split(Part part, std::size_t dimension);
+        /// merges pairs of adjacent fast parts into their union, each part at most once.
+        static void merge_fast_parts(std::vector<Part>& partition);
+        /// @return the dimension along which the parts are adjacent and which they alone differ in, or none.
+        [[nodiscard]] static std::optional<std::size_t> get_merge_dimension(const Part& part, const Part& other);
+        /// @return constraints of the bounds that are tighter than the domain, nullptr for the whole domain.
+        [[nodiscard]] std::unique_ptr<Expression> to_expression(const Part& part) const;
+    };
+
+} // namespace VerificationMethods
+
+#endif //INPUT_SPLITTING_H
@@ -23,6 +23,8 @@
 #include "../../successor_generation/action_op.h"
 #include "../../successor_generation/successor_generator_c.h"
 #include "../start_generation_statistics.h"
+#include "../start_generator_options.h"
+#include "solver_time_limits.h"
 #include <memory>
 
 namespace VerificationMethods {
@@ -31,6 +33,17 @@ namespace VerificationMethods {
         const PLAJA::Configuration& config,
         PLAJA::StatsBase& searchStatistics,
         StartGenerationStatistics* perIterStats):
+        InvariantStrengthening(
+            config,
+            searchStatistics,
+            perIterStats,
+            PLAJA_OPTION::START_GENERATOR::get_int_option(config, PLAJA_OPTION::input_splitting)) {}
+
+    InvariantStrengthening::InvariantStrengthening(
+        const PLAJA::Configuration& config,
+        PLAJA::StatsBase& searchStatistics,
+        StartGenerationStatistics* perIterStats,
+        const int split_solvers):
         model_z3(set_z3_model(config)),
         solver_z3(PLAJA_UTILS::cast_unique<Z3_IN_PLAJA::SMTSolver>(model_z3->init_solver(config, 1))),
         search_stats(searchStatistics),
@@ -42,14 +55,26 @@ namespace VerificationMethods {
             solver_marabou =
                 PLAJA_UTILS::cast_unique<MARABOU_IN_PLAJA::SMTSolver>(model_marabou->init_solver(config, 1));
             model_marabou->add_nn_to_query(solver_marabou->_query(), 0); // Encode policy.
+
+            if (split_solvers > 0) {
+                input_splitting = std::make_unique<InputSplitting>(
+                    config,
+                    *model_marabou,
+                    split_solvers,
+                    PLAJA_OPTION::START_GENERATOR::get_double_option(config, PLAJA_OPTION::split_timeout));
+            }
         }
     }
 
-    std::unordered_set<std::unique_ptr<StateBase>> InvariantStrengthening::run(const Expression& start, const Expression& unsafety) {
+    std::unordered_set<std::unique_ptr<StateBase>> InvariantStrengthening::run(
+        const Expression& start,
+        const Expression& unsafety,
+        const StartGenerator::Deadline& deadline) {
         // run verification.
+        unsafe_states.clear(); // the method is reused across iterations.
         PUSH_LAP(&search_stats, PLAJA::StatsDouble::TOTAL_VERIFICATION_TIME);
         PUSH_LAP_IF(per_iteration_stats, PLAJA::StatsDouble::SEARCHING_TIME);
-        verify(start, unsafety);
+        verify(start, unsafety, deadline);
         POP_LAP(&search_stats, PLAJA::StatsDouble::TOTAL_VERIFICATION_TIME);
         POP_LAP_IF(per_iteration_stats, PLAJA::StatsDouble::SEARCHING_TIME);
         search_stats.inc_attr_unsigned(PLAJA::StatsUnsigned::UNSAFE_STATES_VERIFIED, unsafe_states.size());
@@ -66,12 +91,14 @@ namespace VerificationMethods {
      *
      * Checks all update functions of all action labels in order to find a state in the invariant with a transition to
      * the non-invariant. If found it is added to `unsafe_states` set for refinement.
+     * Every check is bounded by the deadline, and once it expired, no further queries are issued.
      *
      * @return true if the start condition is not safe, false otherwise.
      */
     void InvariantStrengthening::verify(
         const Expression& start,
-        const Expression& unsafety) {
+        const Expression& unsafety,
+        const StartGenerator::Deadline& deadline) {
         std::cout << "Verifying ..." << '\n';
         const bool has_nn = model_z3->has_nn();
         PLAJA_ASSERT(not has_nn or (model_marabou and solver_marabou))
@@ -90,29 +117,33 @@ namespace VerificationMethods {
         if (model_marabou) {
             model_marabou->add_to_solver(*solver_marabou, start, 0);
             model_marabou->add_to_solver(*solver_marabou, unsafety, 1);
+            if (input_splitting) { input_splitting->push(start, unsafety); }
         }
         /* Iterate labels. */
         for (auto it_action = suc_gen.init_action_id_it(true); !it_action.end(); ++it_action) {
+            if (deadline.is_expired()) { break; } // checks are bounded by the deadline, see solver_time_limits.h.
             const auto action_label = it_action.get_label();
 
             const bool is_learned = (has_nn and model_marabou->get_interface()->is_learned(action_label));
             if (is_learned) {
                 if (has_nn) { model_marabou->add_output_interface(*solver_marabou, action_label, 0); }
+                if (input_splitting) { input_splitting->add_output_interface(action_label); }
             }
 
             /* Iterate ops. */
             for (auto it_op = suc_gen.init_action_it_static(action_label); !it_op.end(); ++it_op) {
+                if (deadline.is_expired()) { break; }
                 const auto& action_op = it_op.operator*();
 
                 for (auto it_upd = action_op.updateIterator(); !it_upd.end(); ++it_upd) {
 
                     /* Check non-policy transition. */
-                    if (!exists_non_policy_transitions(action_op._op_id(), it_upd.update_index(), do_locs)) {
+                    if (!exists_non_policy_transitions(action_op._op_id(), it_upd.update_index(), do_locs, deadline)) {
                         continue; // no transition exists
                     }
 
                     if (has_nn) {
-                        if (!exists_policy_transitions(action_op._op_id(), it_upd.update_index(), do_locs)) {
+                        if (!exists_policy_transitions(action_op._op_id(), it_upd.update_index(), do_locs, deadline)) {
                             continue; // no policy transition exists
                         }
                     }
@@ -123,6 +154,10 @@ namespace VerificationMethods {
             }
         }
         if (has_nn) { solver_marabou->pop(); }
+        if (input_splitting) {
+            input_splitting->pop();
+            if (per_iteration_stats) { per_iteration_stats->set_input_parts(input_splitting->num_parts()); }
+        }
         solver_z3->pop();
         [[maybe_unused]] const bool agree = unsafe_states.empty() == violation_found;
         assert(agree);
@@ -135,14 +170,17 @@ namespace VerificationMethods {
      * Uses Z3 to check the existence of any transition between invariant and non-invariant.
      * Excludes the NN for the set of constraints checked.
      * In case a transition exits adds the invariant state with the transition to the set of unsafe states.
+     * The check is bounded by the deadline.
      *
      * @return true if a transition exists, false otherwise.
      */
     bool InvariantStrengthening::exists_non_policy_transitions(
         ActionOpID_type action_op_id,
         UpdateIndex_type update_index,
-        bool do_locs) {
+        bool do_locs,
+        const StartGenerator::Deadline& deadline) {
 
+        limit_checks(*solver_z3, deadline);
         solver_z3->push();
         model_z3->add_action_op(*solver_z3, action_op_id, update_index, do_locs, true, 0);
         const bool rlt = solver_z3->check_pop();
@@ -155,16 +193,24 @@ namespace VerificationMethods {
      *
      * Uses Marabou with the NN encoded to determine existence of policy induced transitions.
      * In case a transition exits adds the invariant state with the transition to the set of unsafe states.
+     * With input splitting, the query is checked part by part on the solvers of `input_splitting`.
      *
      * @return True if transition exists, false otherwise.
      */
     bool InvariantStrengthening::exists_policy_transitions(
         ActionOpID_type action_op_id,
         UpdateIndex_type update_index,
-        bool do_locs) {
+        bool do_locs,
+        const StartGenerator::Deadline& deadline) {
+        if (input_splitting) {
+            solution_solver = input_splitting->exists_policy_transition(action_op_id, update_index, do_locs, deadline);
+            return solution_solver != nullptr;
+        }
+
+        solution_solver = solver_marabou.get();
         solver_marabou->push();
         model_marabou->add_action_op(*solver_marabou, action_op_id, update_index, do_locs, true, 0);
-        const bool rlt = solver_marabou->check();
+        const bool rlt = check_within(*solver_marabou, deadline.remaining()) == CheckResult::Sat;
         solver_marabou->pop();
 
         if (not rlt) {
@@ -178,13 +224,13 @@ namespace VerificationMethods {
     void InvariantStrengthening::extract_solver_solution(const bool do_locs) {
         auto solution_state = model_marabou->get_model_info().get_initial_values();
         model_marabou->get_state_indexes(0).extract_solution(
-            solver_marabou->extract_solution(),
+            solution_solver->extract_solution(),
             solution_state,
             do_locs);
         unsafe_states.emplace(solution_state.to_ptr());
         // after check_pop BB marabou was calling reset but solution was lost therefore the reset now
         // happens after solution is extracted.
-        solver_marabou->reset();
+        solution_solver->reset();
     }
 
     std::shared_ptr<const ModelZ3> InvariantStrengthening::set_z3_model(const PLAJA::Configuration& config) {
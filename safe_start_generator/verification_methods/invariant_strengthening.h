@@ -13,6 +13,7 @@
 #include "../../smt_nn/model/model_marabou.h"
 // #include "../../states/forward_states.h"
 #include "../testing/unsafe_path_identifier.h"
+#include "input_splitting.h"
 #include "verification_method.h"
 
 #include <memory>
@@ -40,8 +41,20 @@ namespace VerificationMethods {
             const PLAJA::Configuration& config,
             PLAJA::StatsBase& searchStatistics,
             StartGenerationStatistics* perIterStats);
+        /// @param split_solvers solvers of the input splitting of policy queries, 0 for none, instead of the option.
+        InvariantStrengthening(
+            const PLAJA::Configuration& config,
+            PLAJA::StatsBase& searchStatistics,
+            StartGenerationStatistics* perIterStats,
+            int split_solvers);
+
+        /// @return whether the model has a policy network, i.e., whether policy queries are checked by Marabou.
+        [[nodiscard]] bool has_policy_queries() const { return model_marabou != nullptr; }
 
-        std::unordered_set<std::unique_ptr<StateBase>> run(const Expression& start, const Expression& unsafety) override;
+        std::unordered_set<std::unique_ptr<StateBase>> run(
+            const Expression& start,
+            const Expression& unsafety,
+            const StartGenerator::Deadline& deadline) override;
 
     private:
         std::shared_ptr<const ModelZ3> model_z3;
@@ -50,15 +63,25 @@ namespace VerificationMethods {
         // NN
         std::unique_ptr<ModelMarabou> model_marabou;
         std::unique_ptr<MARABOU_IN_PLAJA::SMTSolver> solver_marabou;
+        std::unique_ptr<InputSplitting> input_splitting; // optional, replaces `solver_marabou` for policy queries.
+        MARABOU_IN_PLAJA::SMTSolver* solution_solver = nullptr; // solver of the last satisfiable policy query.
 
         std::unordered_set<std::unique_ptr<StateBase>> unsafe_states;
 
         PLAJA::StatsBase& search_stats;
         StartGenerationStatistics* per_iteration_stats;
 
-        void verify(const Expression& start, const Expression& unsafety);
-        bool exists_non_policy_transitions(ActionOpID_type action_op_id, UpdateIndex_type update_index, bool do_locs);
-        bool exists_policy_transitions(ActionOpID_type action_op_id, UpdateIndex_type update_index, bool do_locs);
+        void verify(const Expression& start, const Expression& unsafety, const StartGenerator::Deadline& deadline);
+        bool exists_non_policy_transitions(
+            ActionOpID_type action_op_id,
+            UpdateIndex_type update_index,
+            bool do_locs,
+            const StartGenerator::Deadline& deadline);
+        bool exists_policy_transitions(
+            ActionOpID_type action_op_id,
+            UpdateIndex_type update_index,
+            bool do_locs,
+            const StartGenerator::Deadline& deadline);
         void extract_solver_solution(bool do_locs);
         std::shared_ptr<const ModelZ3> set_z3_model(const PLAJA::Configuration& config);
     };
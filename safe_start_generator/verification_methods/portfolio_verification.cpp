@@ -0,0 +1,197 @@
+//
+// Created by Daniel Sherbakov in 2025.
+//
+
+#include "portfolio_verification.h"
+
+#include "../../../assertions.h"
+#include "../../../stats/stats_base.h"
+#include "../../factories/configuration.h"
+#include "../start_generation_statistics.h"
+#include "../start_generator_options.h"
+#include "invariant_strengthening.h"
+#include "verification_method_factory.h"
+
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <thread>
+
+namespace VerificationMethods {
+
+    /**
+     * Races plain invariant strengthening against invariant strengthening with input-split policy queries; the two
+     * differ only in how Marabou is used, which is where their running times diverge. PA CEGAR runs in a turn of its
+     * own.
+     */
+    PortfolioVerification::PortfolioVerification(
+        const PLAJA::Configuration& config,
+        PLAJA::StatsBase& search_statistics,
+        StartGenerationStatistics* per_iteration_stats):
+        search_stats(search_statistics),
+        per_iteration_stats(per_iteration_stats) {
+        using Create =
+            std::function<std::unique_ptr<VerificationMethod>(const PLAJA::Configuration&, PLAJA::StatsBase&)>;
+        const auto add_member = [this, &config](
+                                    std::string name,
+                                    std::unique_ptr<PLAJA::Configuration> own_config,
+                                    const Create& create,
+                                    const bool interruptible) {
+            Member member;
+            member.name = std::move(name);
+            member.config = std::move(own_config);
+            member.stats = std::make_unique<PLAJA::StatsBase>();
+            StartGenerationStatistics::add_basic_stats(*member.stats);
+            // per-iteration statistics are recorded by the portfolio.
+            const auto* member_config = member.config ? member.config.get() : &config;
+            member.method = create(*member_config, *member.stats);
+            member.interruptible = interruptible;
+            members.push_back(std::move(member));
+            return members.size() - 1;
+        };
+
+        Turn race_turn;
+        bool has_policy_queries = false;
+        race_turn.members.push_back(add_member(
+            type_to_string(Type::INVARIANT_STRENGTHENING),
+            nullptr,
+            [&has_policy_queries](const PLAJA::Configuration& member_config, PLAJA::StatsBase& stats) {
+                auto method = std::make_unique<InvariantStrengthening>(member_config, stats, nullptr, 0);
+                has_policy_queries = method->has_policy_queries();
+                return method;
+            },
+            true));
+        if (has_policy_queries) {
+            // a Z3 context must not be used by two threads, hence this member builds a Z3 model of its own.
+            auto own_config = std::make_unique<PLAJA::Configuration>(config);
+            own_config->delete_sharable(PLAJA::SharableKey::MODEL_Z3);
+            const int split_solvers = std::max(
+                min_split_solvers,
+                PLAJA_OPTION::START_GENERATOR::get_int_option(config, PLAJA_OPTION::input_splitting));
+            race_turn.members.push_back(add_member(
+                type_to_string(Type::INVARIANT_STRENGTHENING) + "_INPUT_SPLITTING",
+                std::move(own_config),
+                [split_solvers](const PLAJA::Configuration& member_config, PLAJA::StatsBase& stats) {
+                    return std::make_unique<InvariantStrengthening>(member_config, stats, nullptr, split_solvers);
+                },
+                true));
+        }
+        turns.push_back(std::move(race_turn));
+
+        turns.emplace_back().members.push_back(add_member(
+            type_to_string(Type::START_CONDITION_STRENGTHENING),
+            nullptr,
+            [](const PLAJA::Configuration& member_config, PLAJA::StatsBase& stats) {
+                return VerificationMethodFactory::create(
+                    Type::START_CONDITION_STRENGTHENING,
+                    member_config,
+                    stats,
+                    nullptr);
+            },
+            false));
+    }
+
+    PortfolioVerification::~PortfolioVerification() = default;
+
+    void PortfolioVerification::set_property(const std::size_t property_index) {
+        for (auto& member: members) { member.method->set_property(property_index); }
+    }
+
+    std::unordered_set<std::unique_ptr<StateBase>> PortfolioVerification::run(
+        const Expression& start,
+        const Expression& unsafety,
+        const StartGenerator::Deadline& deadline) {
+        PUSH_LAP(&search_stats, PLAJA::StatsDouble::TOTAL_VERIFICATION_TIME);
+        PUSH_LAP_IF(per_iteration_stats, PLAJA::StatsDouble::SEARCHING_TIME);
+        ++num_iterations;
+
+        auto& turn = turns[select_turn()];
+        const auto begin = std::chrono::steady_clock::now();
+        std::unordered_set<std::unique_ptr<StateBase>> unsafe_states;
+        std::string winner_name;
+        if (turn.members.size() == 1) {
+            auto& member = members[turn.members.front()];
+            unsafe_states = member.method->run(start, unsafety, deadline);
+            winner_name = member.name;
+        } else {
+            unsafe_states = race(turn.members, start, unsafety, deadline, winner_name);
+        }
+        // a run cut off by the deadline says little about the speed of the turn.
+        if (not deadline.is_expired()) {
+            ++turn.runs;
+            turn.total_time += std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+        }
+
+        POP_LAP(&search_stats, PLAJA::StatsDouble::TOTAL_VERIFICATION_TIME);
+        POP_LAP_IF(per_iteration_stats, PLAJA::StatsDouble::SEARCHING_TIME);
+        search_stats.inc_attr_unsigned(PLAJA::StatsUnsigned::UNSAFE_STATES_VERIFIED, unsafe_states.size());
+        if (per_iteration_stats) {
+            per_iteration_stats->inc_unsigned(PLAJA::StatsUnsigned::UNSAFE_STATES, unsafe_states.size());
+            per_iteration_stats->set_verification_winner(winner_name);
+        }
+        return unsafe_states;
+    }
+
+    std::unordered_set<std::unique_ptr<StateBase>> PortfolioVerification::race(
+        const std::vector<std::size_t>& participants,
+        const Expression& start,
+        const Expression& unsafety,
+        const StartGenerator::Deadline& deadline,
+        std::string& winner_name) {
+        ++num_races;
+        std::mutex mutex;
+        std::optional<std::size_t> winner;
+        std::unordered_set<std::unique_ptr<StateBase>> result;
+
+        const auto race_deadline = deadline.cancellable();
+        std::vector<std::thread> threads;
+        threads.reserve(participants.size());
+        for (const auto index: participants) {
+            PLAJA_ASSERT(members[index].interruptible)
+            threads.emplace_back([&, index]() {
+                auto states = members[index].method->run(start, unsafety, race_deadline);
+                // a result after cancellation or timeout may be incomplete.
+                const bool conclusive = not race_deadline.is_expired();
+                std::lock_guard<std::mutex> lock(mutex);
+                if (winner) { return; }
+                if (conclusive) {
+                    winner = index;
+                    race_deadline.cancel();
+                }
+                result = std::move(states);
+            });
+        }
+        // all members are interruptible, so the others stop shortly after the first conclusive result.
+        for (auto& thread: threads) { thread.join(); }
+
+        if (winner) {
+            auto& member = members[*winner];
+            ++member.wins;
+            winner_name = member.name;
+            PLAJA_LOG("Portfolio: " + member.name + " won " + std::to_string(member.wins) + " of "
+                      + std::to_string(num_races) + " races.")
+        } else {
+            PLAJA_LOG("Portfolio: no conclusive result before the deadline.")
+        }
+        return result;
+    }
+
+    std::size_t PortfolioVerification::select_turn() const {
+        std::size_t least_measured = 0;
+        for (std::size_t index = 1; index < turns.size(); ++index) {
+            if (turns[index].runs < turns[least_measured].runs) { least_measured = index; }
+        }
+        if (turns[least_measured].runs < warmup_runs or num_iterations % remeasure_interval == 0) {
+            return least_measured;
+        }
+
+        std::size_t fastest = 0;
+        for (std::size_t index = 1; index < turns.size(); ++index) {
+            if (turns[index].mean_time() < turns[fastest].mean_time()) { fastest = index; }
+        }
+        return fastest;
+    }
+
+} // namespace VerificationMethods
@@ -0,0 +1,98 @@
+//
+// Created by Daniel Sherbakov in 2025.
+//
+
+#ifndef PORTFOLIO_VERIFICATION_H
+#define PORTFOLIO_VERIFICATION_H
+
+#include "../../../utils/default_constructors.h"
+#include "verification_method.h"
+
+#include <memory>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+class StartGenerationStatistics;
+namespace PLAJA {
+    class Configuration;
+    class StatsBase;
+}
+
+namespace VerificationMethods {
+
+    /**
+     * @brief Selects among several verification methods on the same start and unsafety condition.
+     *
+     * The members are grouped into turns. Members whose runs can be cancelled share a turn: they race on their own
+     * threads with private statistics, the first conclusive result is used and the others are cancelled. These are two
+     * `InvariantStrengthening` instances, whose solver checks are bounded by the deadline, one checking policy queries
+     * in a single Marabou query and one splitting them over several, each on a Z3 model of its own. A PA CEGAR run of
+     * `StartConditionStrengthening` cannot be interrupted, so such a member never runs concurrently but gets a turn of
+     * its own on the calling thread.
+     * No member runs past `run`, i.e., the generator never refines the conditions or draws from the shared generators
+     * while a member still works.
+     *
+     * Turns alternate during a warm-up. Afterwards, the turn with the lowest mean verification time runs, and every few
+     * iterations the least measured turn runs instead, to notice when another method becomes faster.
+     */
+    class PortfolioVerification final: public VerificationMethod {
+    public:
+        PortfolioVerification(
+            const PLAJA::Configuration& config,
+            PLAJA::StatsBase& search_statistics,
+            StartGenerationStatistics* per_iteration_stats);
+        ~PortfolioVerification() override;
+        DELETE_CONSTRUCTOR(PortfolioVerification)
+
+        std::unordered_set<std::unique_ptr<StateBase>> run(
+            const Expression& start,
+            const Expression& unsafety,
+            const StartGenerator::Deadline& deadline) override;
+
+        void set_property(std::size_t property_index) override;
+
+    private:
+        /// runs of every turn before the fastest one is preferred.
+        static constexpr std::size_t warmup_runs = 3;
+        /// iterations between runs of the least measured turn.
+        static constexpr std::size_t remeasure_interval = 5;
+        /// solvers of the input-splitting member, at least.
+        static constexpr int min_split_solvers = 2;
+
+        struct Member {
+            std::string name;
+            std::unique_ptr<PLAJA::Configuration> config; // own copy if the member must not share the Z3 model.
+            std::unique_ptr<PLAJA::StatsBase> stats; // racing members cannot share the statistics.
+            std::unique_ptr<VerificationMethod> method;
+            bool interruptible;
+            std::size_t wins = 0; // of races.
+        };
+
+        struct Turn {
+            std::vector<std::size_t> members; // more than one only if all are interruptible.
+            std::size_t runs = 0; // completed before the deadline.
+            double total_time = 0; // of these runs.
+            [[nodiscard]] double mean_time() const { return total_time / static_cast<double>(runs); }
+        };
+
+        PLAJA::StatsBase& search_stats;
+        StartGenerationStatistics* per_iteration_stats;
+        std::vector<Member> members;
+        std::vector<Turn> turns;
+        std::size_t num_races = 0;
+        std::size_t num_iterations = 0;
+
+        [[nodiscard]] std::size_t select_turn() const;
+        /// @return unsafe states of the first conclusive member, or of the last one if none was conclusive.
+        std::unordered_set<std::unique_ptr<StateBase>> race(
+            const std::vector<std::size_t>& participants,
+            const Expression& start,
+            const Expression& unsafety,
+            const StartGenerator::Deadline& deadline,
+            std::string& winner_name);
+    };
+
+} // namespace VerificationMethods
+
+#endif //PORTFOLIO_VERIFICATION_H
@@ -0,0 +1,74 @@
+//
+// Created by Daniel Sherbakov in 2025.
+//
+
+#include "solver_time_limits.h"
+
+#include "../../../globals.h"
+#include "../../smt/solver/smt_solver_z3.h"
+#include "../../smt_nn/solver/smt_solver_marabou.h"
+
+#include "Engine.h"
+#include "InputQuery.h"
+#include <z3++.h>
+
+#include <algorithm>
+#include <climits>
+#include <cmath>
+
+namespace VerificationMethods {
+
+    namespace {
+
+        /**
+         * Loads the solution of the engine into the solver: with the inputs fixed to their solution values, the
+         * network is evaluated by bound propagation alone, so this check costs no search.
+         * @return false if the solver does not confirm the solution, e.g., due to floating point tolerances.
+         */
+        bool hold_solution(MARABOU_IN_PLAJA::SMTSolver& solver, const InputQuery& solved) {
+            solver.push();
+            for (const auto var: solved.getInputVariables()) {
+                const auto value = solved.getSolutionValue(var);
+                solver._query().set_lower_bound(var, value);
+                solver._query().set_upper_bound(var, value);
+            }
+            const bool confirmed = solver.check();
+            solver.pop(); // the solution is kept until the next check.
+            return confirmed;
+        }
+
+    } // namespace
+
+    CheckResult check_within(MARABOU_IN_PLAJA::SMTSolver& solver, const double seconds) {
+        if (std::isinf(seconds)) { return solver.check() ? CheckResult::Sat : CheckResult::Unsat; }
+
+        InputQuery query(solver._query()); // preprocessing modifies the query.
+        Engine engine;
+        if (not engine.processInputQuery(query)) { return CheckResult::Unsat; } // infeasible bounds.
+        engine.solve(static_cast<unsigned>(std::max(1.0, std::ceil(seconds))));
+        switch (engine.getExitCode()) {
+            case Engine::UNSAT: return CheckResult::Unsat;
+            case Engine::SAT: {
+                engine.extractSolution(query);
+                if (hold_solution(solver, query)) { return CheckResult::Sat; }
+                return solver.check() ? CheckResult::Sat : CheckResult::Unsat; // rare, not worth a wrong answer.
+            }
+            case Engine::ERROR: {
+                PLAJA_LOG("Marabou engine failed on a time-limited check, checking without limit.")
+                return solver.check() ? CheckResult::Sat : CheckResult::Unsat;
+            }
+            default: return CheckResult::Unknown; // timeout or quit.
+        }
+    }
+
+    void limit_checks(Z3_IN_PLAJA::SMTSolver& solver, const StartGenerator::Deadline& deadline) {
+        if (not deadline.is_bounded()) { return; }
+        auto& z3_solver = solver._solver();
+        z3::params params(z3_solver.ctx());
+        // in milliseconds, 0 would disable the timeout.
+        const auto timeout = std::clamp(std::ceil(deadline.remaining() * 1000), 1.0, static_cast<double>(UINT_MAX));
+        params.set("timeout", static_cast<unsigned>(timeout));
+        z3_solver.set(params);
+    }
+
+} // namespace VerificationMethods
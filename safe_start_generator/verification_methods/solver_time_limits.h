@@ -0,0 +1,40 @@
+//
+// Created by Daniel Sherbakov in 2025.
+//
+
+#ifndef SOLVER_TIME_LIMITS_H
+#define SOLVER_TIME_LIMITS_H
+
+#include "../../smt/forward_smt_z3.h"
+#include "../../smt_nn/forward_smt_nn.h"
+#include "../deadline.h"
+
+/**
+ * Time limits for single solver checks, so that a check does not run past the deadline of its verification run.
+ * Deadlines are otherwise only polled between checks.
+ */
+namespace VerificationMethods {
+
+    enum class CheckResult { Sat, Unsat, Unknown };
+
+    /**
+     * @brief Checks the current query of the Marabou solver within the given number of seconds (unbounded if infinite).
+     *
+     * PlaJA's Marabou solver has no time limit and cannot be interrupted, hence the query is first solved on a separate
+     * Marabou engine, which gives up after the limit (rounded up to whole seconds). For a satisfiable query, the solver
+     * is then given the solution of the engine, so that it holds the solution without searching again. If the engine
+     * fails, the query is checked on the solver without limit instead.
+     *
+     * @return Unknown if the limit was reached.
+     */
+    CheckResult check_within(MARABOU_IN_PLAJA::SMTSolver& solver, double seconds);
+
+    /**
+     * @brief Bounds the checks of the Z3 solver by the deadline, via Z3's timeout parameter.
+     * A check that times out is unknown, i.e., not satisfiable.
+     */
+    void limit_checks(Z3_IN_PLAJA::SMTSolver& solver, const StartGenerator::Deadline& deadline);
+
+} // namespace VerificationMethods
+
+#endif //SOLVER_TIME_LIMITS_H
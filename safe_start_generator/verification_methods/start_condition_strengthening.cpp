@@ -19,7 +19,12 @@ StartConditionStrengthening::StartConditionStrengthening(
     per_iteration_stats(per_iteration_statistics),
     config(config){}
 
-std::unordered_set<std::unique_ptr<StateBase>> StartConditionStrengthening::run(const Expression& start, const Expression& unsafety) {
+std::unordered_set<std::unique_ptr<StateBase>> StartConditionStrengthening::run(
+    const Expression& start,
+    const Expression& unsafety,
+    const StartGenerator::Deadline& deadline) {
+    // a PA CEGAR run cannot be interrupted, hence the deadline is only checked before starting it.
+    if (deadline.is_expired()) { return {}; }
     init_pa_cegar(start);
     PUSH_LAP(&search_stats, PLAJA::StatsDouble::TOTAL_VERIFICATION_TIME);
     PUSH_LAP_IF(per_iteration_stats, PLAJA::StatsDouble::SEARCHING_TIME);
@@ -43,7 +48,7 @@ void StartConditionStrengthening::init_pa_cegar(const Expression& start) {
     // therefore the config is copied and we delete the model z3 from the shared objects.
     auto subconfig(config);
     const auto model = PLAJA_GLOBAL::currentModel;
-    sub_prop_info = PropertyInformation::analyse_property(*model->get_property(1), *model);
+    sub_prop_info = PropertyInformation::analyse_property(*model->get_property(property_index), *model);
     sub_prop_info->set_start(&start);
     subconfig.delete_sharable(PLAJA::SharableKey::MODEL_Z3);
     subconfig.delete_sharable(PLAJA::SharableKey::PROP_INFO);
@@ -22,6 +22,7 @@ namespace VerificationMethods {
 
         const PLAJA::Configuration& config;
         std::unique_ptr<PropertyInformation> sub_prop_info;
+        std::size_t property_index = 1;
 
         void init_pa_cegar(const Expression& start);
 
@@ -31,7 +32,12 @@ namespace VerificationMethods {
             PLAJA::StatsBase& search_statistics,
             StartGenerationStatistics* per_iteration_statistics);
 
-        std::unordered_set<std::unique_ptr<StateBase>> run(const Expression& start, const Expression& unsafety) override;
+        std::unordered_set<std::unique_ptr<StateBase>> run(
+            const Expression& start,
+            const Expression& unsafety,
+            const StartGenerator::Deadline& deadline) override;
+
+        void set_property(const std::size_t index) override { property_index = index; }
     };
 } // namespace VerificationMethods
 
@@ -6,6 +6,7 @@
 #define STRENGTHENINGMETHOD_H
 
 #include "../../parser/ast/expression/expression.h"
+#include "../deadline.h"
 #include "../testing/policy_run_sampling.h"
 #include <memory>
 #include <utility>
@@ -13,8 +14,17 @@
 class VerificationMethod {
 public:
     virtual ~VerificationMethod() = default;
-    /// @return a set of unsafe states.
-    virtual std::unordered_set<std::unique_ptr<StateBase>> run(const Expression& start, const Expression& unsafety) = 0;
+    /**
+     * @return a set of unsafe states.
+     * The method stops at the deadline and returns the states found so far; an empty result then does not prove safety.
+     */
+    virtual std::unordered_set<std::unique_ptr<StateBase>> run(
+        const Expression& start,
+        const Expression& unsafety,
+        const StartGenerator::Deadline& deadline) = 0;
+
+    /// called when a batch moves on to the next property (index into the model's properties).
+    virtual void set_property(std::size_t /*property_index*/) {}
 };
 
 #endif //STRENGTHENINGMETHOD_H
@@ -8,6 +8,7 @@
 #include "../../smt_nn/solver/smt_solver_marabou.h"
 #include "../../stats/stats_base.h"
 #include "invariant_strengthening.h"
+#include "portfolio_verification.h"
 #include "start_condition_strengthening.h"
 
 #include <functional>
@@ -29,6 +30,13 @@ namespace VerificationMethods {
         StartGenerationStatistics* per_iteration_stats) {
         return std::make_unique<StartConditionStrengthening>(config, search_statistics, per_iteration_stats);
     }
+
+    std::unique_ptr<VerificationMethod> createPortfolio(
+        const PLAJA::Configuration& config,
+        PLAJA::StatsBase& search_statistics,
+        StartGenerationStatistics* per_iteration_stats) {
+        return std::make_unique<PortfolioVerification>(config, search_statistics, per_iteration_stats);
+    }
     // ============================================================================
     // Factory method:
     std::unique_ptr<VerificationMethod> VerificationMethodFactory::create(
@@ -45,7 +53,8 @@ namespace VerificationMethods {
         // supported methods
         static const std::unordered_map<Type, CreatorFn> factoryMap = {
             {Type::INVARIANT_STRENGTHENING, createInvariantStrengthening},
-            {Type::START_CONDITION_STRENGTHENING, createStartConditionStrengthening}
+            {Type::START_CONDITION_STRENGTHENING, createStartConditionStrengthening},
+            {Type::PORTFOLIO, createPortfolio}
         };
 
         auto it = factoryMap.find(method);
@@ -12,6 +12,7 @@ namespace VerificationMethods {
         switch (type) {
             case Type::INVARIANT_STRENGTHENING: return "inv_str";
             case Type::START_CONDITION_STRENGTHENING: return "scs";
+            case Type::PORTFOLIO: return "portfolio";
             default: throw std::invalid_argument("Unknown verification method");
         }
     }
@@ -19,6 +20,7 @@ namespace VerificationMethods {
     Type string_to_type(const std::string& type_str) {
         if (type_str == "inv_str") return Type::INVARIANT_STRENGTHENING;
         if (type_str == "scs") return Type::START_CONDITION_STRENGTHENING;
+        if (type_str == "portfolio") return Type::PORTFOLIO;
         throw std::invalid_argument("Invalid verification method string: " + type_str);
     }
 }
\ No newline at end of file
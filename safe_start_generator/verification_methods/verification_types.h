@@ -11,7 +11,8 @@
 namespace VerificationMethods {
     enum class Type {
         INVARIANT_STRENGTHENING,
-        START_CONDITION_STRENGTHENING
+        START_CONDITION_STRENGTHENING,
+        PORTFOLIO, // races the methods above, uses the conditions of invariant strengthening.
     };
     std::string type_to_string(Type type);
     Type string_to_type(const std::string& type);